@@ -32,6 +32,7 @@ coded without (much) regard for the hardware that it runs on.
 */
 
 #include "bas51.h"
+#include "stats.h"
 
 #ifdef __BORLANDC__
 
@@ -290,6 +291,157 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
 
 
 
+#ifdef __unix__
+
+// Headless POSIX version.  The screen is copied to stdout and the keyboard
+// comes from stdin.
+//
+//   bas51                  Interactive, same as the Win32 version.
+//   bas51 --run prog.bas   Load prog.bas, run it and exit without ever
+//                          entering the editor.  The exit status is the
+//                          error code that stopped the program, 255 if it
+//                          was stopped by STOP or break, or 0.
+//   bas51 --run prog.b51   The same for a binary image made with
+//                          SAVE "prog.b51",B.
+//   bas51 --resume x.snp   Carry on from where SNAPSHOT "x.snp" was taken,
+//                          then exit the same way as --run.
+//   bas51 --stats --run prog.bas
+//                          Also print the STATS counters to stderr when
+//                          the program ends.  bench/run.sh uses this.
+
+#include <strings.h>
+
+void PROGMAIN(void);
+void InitConsole(void);
+void SetBasFileDir(char *Dir);
+extern BIT ConsoleEcho;
+extern BIT LoadEcho;
+extern BYTE ExitStatus;
+extern CODE char *StatNames[STAT_COUNT];  // command.c
+
+
+// Tokenize an immediate mode command and point the stream at it.
+// Returns TRUE on error.
+
+static BIT StartImmediate(char *Cmd)
+{
+    strcpy((char *) InBuf, Cmd);
+    if (TokenizeLine(InBuf, (BYTE) strlen(Cmd)) || StoreBasicLine(NULL) != 0xFFFF)
+    {
+        PrintErrorCode();
+        return(TRUE);
+    }
+
+    CurChar = '\r';
+    SetStream51(BasicVars.CmdLine);
+    Running = TRUE;
+    return(FALSE);
+}
+
+
+// Load and run a program without the editor, or resume a snapshot.
+
+static int RunProgram(char *Path, BIT Resume)
+{
+    static char Dir[256];
+    char Cmd[128];
+    char *Name, *Ext;
+
+    // LOAD works on names relative to the BasFiles directory, so point
+    // that at the directory the program is in.
+    Name = strrchr(Path, '/');
+    if (Name)
+    {
+        Name++;
+        sprintf(Dir, "%.*s", (int)(Name - Path), Path);
+        SetBasFileDir(Dir);
+    }
+    else
+    {
+        Name = Path;
+        SetBasFileDir("./");
+    }
+
+    if (strlen(Name) > 100 || strchr(Name, '"'))
+    {
+        fprintf(stderr, "bas51: bad file name %s\n", Path);
+        return(255);
+    }
+
+    MemInit51();
+    InitScreenCount();
+    VGA_ClrScrn();
+    ExitStatus = ERROR_NONE;
+
+    // Load quietly.  The LOAD statement is the only one on the line, so
+    // if Running is still set afterwards the file had an AUTO RUN in it.
+    ConsoleEcho = FALSE;
+    LoadEcho = FALSE;
+    Ext = strrchr(Name, '.');
+    if (Resume)
+        sprintf(Cmd, "RESTORE SNAPSHOT \"%s\"", Name);
+    else
+        sprintf(Cmd, "LOAD \"%s\"%s", Name,
+                Ext && strcasecmp(Ext, ".b51") == 0 ? ",B" : "");
+    if (!StartImmediate(Cmd)) ExecuteLine();
+    ConsoleEcho = TRUE;
+    LoadEcho = TRUE;
+    if (ExitStatus != ERROR_NONE)
+    {
+        fprintf(stderr, "bas51: cannot load %s, error %d\n", Path, ExitStatus);
+        return(ExitStatus);
+    }
+
+    StopLinePtr = 0;
+    if (Running || !StartImmediate("RUN"))
+        while (Running) ExecuteLine();
+    fflush(stdout);
+
+    if (ExitStatus == ERROR_NONE && StopLinePtr) return(255);
+    return(ExitStatus);
+}
+
+
+int main(int argc, char *argv[])
+{
+    BIT ShowStats;
+    int Status;
+    BYTE i;
+
+    InitConsole();
+
+    ShowStats = (BIT)(argc == 4 && strcmp(argv[1], "--stats") == 0);
+    if (ShowStats)
+    {
+        argc--;
+        argv++;
+    }
+
+    if (argc == 3 && (strcmp(argv[1], "--run") == 0 ||
+                      strcmp(argv[1], "--resume") == 0))
+    {
+        Status = RunProgram(argv[2], (BIT)(strcmp(argv[1], "--resume") == 0));
+        if (ShowStats)
+            for (i = 0; i != STAT_COUNT; i++)
+                fprintf(stderr, "%s %lu\n", StatNames[i],
+                        (unsigned long) Stats[i]);
+        return(Status);
+    }
+
+    if (argc != 1 || ShowStats)
+    {
+        fprintf(stderr, "usage: bas51 [--stats] [--run prog.bas | --resume file.snp]\n");
+        return(255);
+    }
+
+    PROGMAIN();
+    return(0);
+}
+
+#endif
+
+
+
 
 
 
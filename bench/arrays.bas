@@ -0,0 +1,8 @@
+10 REM ARRAY TRAVERSAL
+20 DIM A(500), M(20,20)
+30 FOR K=1 TO 100
+40 FOR I=0 TO 500: A(I)=A(I)+I*K: NEXT I
+50 FOR I=0 TO 20: FOR J=0 TO 20: M(I,J)=M(J,I)+A(I+J): NEXT J: NEXT I
+60 NEXT K
+70 S=0: FOR I=0 TO 500: S=S+A(I): NEXT I
+80 PRINT S; M(20,20)
@@ -0,0 +1,7 @@
+10 REM FLOAT ARITHMETIC AND FUNCTIONS THROUGH EVALUATE
+20 X=0: Y=1.5
+30 FOR I=1 TO 100000
+40 X=X+Y*I/7-SQR(I)+SIN(I/100)*2.5
+50 Y=Y*0.9999+0.0001
+60 NEXT I
+70 PRINT INT(X)
@@ -0,0 +1,61 @@
+10 REM GOSUB HEAVY CODE, SUBROUTINES FAR FROM THE CALLERS
+20 S=0
+30 FOR I=1 TO 100000
+40 GOSUB 9000
+50 ON I MOD 3 + 1 GOSUB 5000, 6000, 7000
+60 NEXT I
+70 PRINT S
+80 END
+100 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+200 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+300 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+400 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+500 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+600 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+700 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+800 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+900 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1000 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1100 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1200 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1300 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1400 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1500 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1600 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1700 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1800 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+1900 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2000 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2100 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2200 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2300 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2400 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2500 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2600 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2700 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2800 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+2900 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3000 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3100 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3200 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3300 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3400 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3500 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3600 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3700 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3800 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+3900 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4000 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4100 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4200 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4300 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4400 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4500 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4600 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4700 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4800 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+4900 REM PADDING BETWEEN THE CALLERS AND THE SUBROUTINES
+5000 S=S+1: RETURN
+6000 S=S+2: RETURN
+7000 GOSUB 9000: RETURN
+9000 S=S+1: RETURN
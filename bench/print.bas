@@ -0,0 +1,4 @@
+10 REM PRINT HEAVY OUTPUT
+20 FOR I=1 TO 15000
+30 PRINT I; "LINE OF OUTPUT"; I*2.5, CHR$(65+I MOD 26)
+40 NEXT I
@@ -0,0 +1,12 @@
+10 REM READ/DATA SCANS WITH RESTORE
+20 S=0
+30 FOR K=1 TO 5000
+40 RESTORE
+50 FOR I=1 TO 20: READ X, Y$: S=S+X+LEN(Y$): NEXT I
+60 NEXT K
+70 PRINT S
+80 END
+100 DATA 1,"A",2,"BB",3,"CCC",4,"DDDD",5,"E"
+110 DATA 6,"F",7,"GG",8,"HHH",9,"I",10,"JJ"
+120 DATA 11,"K",12,"LL",13,"MMM",14,"N",15,"OO"
+130 DATA 16,"P",17,"QQ",18,"RRR",19,"S",20,"TT"
@@ -0,0 +1,58 @@
+#!/bin/sh
+# BENCH/RUN.SH - Runs every bench/*.bas program with the headless POSIX
+# build and prints the results as JSON on stdout.
+#
+#   bench/run.sh [runs] [bas51]
+#
+# runs defaults to 5 and bas51 to ./bas51 (see Compile-Me.txt).  Each program
+# is run that many times with "bas51 --stats --run".  best_s and mean_s are
+# wall times in seconds, stmts_per_sec is the STATEMENTS counter over the
+# best time, and output_cksum is the cksum of what the program printed, so a
+# change that alters the results shows up too.  A program that does not exit
+# with status 0 is reported with "ok": false.  Needs a date(1) that knows %N.
+
+Runs=${1:-5}
+Bas51=${2:-./bas51}
+Dir=$(dirname "$0")
+Tmp=${TMPDIR:-/tmp}/bas51-bench.$$
+
+trap 'rm -f "$Tmp".out "$Tmp".err' EXIT
+
+if [ ! -x "$Bas51" ]; then
+    echo "bench/run.sh: no $Bas51, build it first" >&2
+    exit 1
+fi
+
+printf '{\n  "bas51": "%s",\n  "runs": %d,\n  "results": [' "$Bas51" "$Runs"
+
+Sep=""
+for Prog in "$Dir"/*.bas; do
+    Name=$(basename "$Prog" .bas)
+    Ok=true
+    Times=""
+    i=0
+    while [ $i -lt "$Runs" ]; do
+        Start=$(date +%s%N)
+        "$Bas51" --stats --run "$Prog" > "$Tmp".out 2> "$Tmp".err || Ok=false
+        End=$(date +%s%N)
+        Times="$Times $((End - Start))"
+        i=$((i + 1))
+    done
+
+    Stmts=$(sed -n 's/^STATEMENTS //p' "$Tmp".err)
+    Sum=$(cksum < "$Tmp".out | cut -d ' ' -f 1)
+
+    printf '%s\n    ' "$Sep"
+    echo "$Times" | awk -v name="$Name" -v ok="$Ok" -v stmts="${Stmts:-0}" \
+        -v sum="$Sum" '{
+        best = $1; total = 0
+        for (i = 1; i <= NF; i++) { if ($i < best) best = $i; total += $i }
+        printf "{\"name\": \"%s\", \"ok\": %s, \"statements\": %d, ", name, ok, stmts
+        printf "\"best_s\": %.6f, \"mean_s\": %.6f, ", best / 1e9, total / NF / 1e9
+        printf "\"stmts_per_sec\": %.0f, ", best ? stmts * 1e9 / best : 0
+        printf "\"output_cksum\": %s}", sum
+    }'
+    Sep=","
+done
+
+printf '\n  ]\n}\n'
@@ -0,0 +1,9 @@
+10 REM STRING CONCATENATION AND MID$ CHURN
+20 A$="": N=0
+30 FOR I=1 TO 50000
+40 A$=A$+CHR$(65+I MOD 26)
+50 IF LEN(A$)>60 THEN A$=MID$(A$,20,30)
+60 B$=MID$(A$,2,5)+LEFT$(A$,3)+RIGHT$(A$,4)
+70 N=N+LEN(B$)
+80 NEXT I
+90 PRINT N; A$
@@ -0,0 +1,406 @@
+10 REM TOKENIZER THROUGHPUT, 400 LINES OF ASSIGNMENTS WITH LONG NAMES
+20 REM THE TIME GOES INTO LOADING, THE LINES ARE NEVER RUN.  COMPARE
+30 REM BEST_S WITH THE OTHER BUILD, NOT STATEMENTS PER SECOND
+40 GOTO 9000
+100 QQQQQQQ=WQQQQQQ+ZQQQQQQ*KQQQQQQ-XQQQQQQ/JQQQQQQ
+110 VQQQQQQ=PQQQQQQ+YQQQQQQ*QWQQQQQ-WWQQQQQ/ZWQQQQQ
+120 XWQQQQQ=JWQQQQQ+BWQQQQQ*VWQQQQQ-PWQQQQQ/YWQQQQQ
+130 WZQQQQQ=ZZQQQQQ+KZQQQQQ*XZQQQQQ-JZQQQQQ/BZQQQQQ
+140 PZQQQQQ=YZQQQQQ+QKQQQQQ*WKQQQQQ-ZKQQQQQ/KKQQQQQ
+150 JKQQQQQ=BKQQQQQ+VKQQQQQ*PKQQQQQ-YKQQQQQ/QXQQQQQ
+160 ZXQQQQQ=KXQQQQQ+XXQQQQQ*JXQQQQQ-BXQQQQQ/VXQQQQQ
+170 YXQQQQQ=QJQQQQQ+WJQQQQQ*ZJQQQQQ-KJQQQQQ/XJQQQQQ
+180 BJQQQQQ=VJQQQQQ+PJQQQQQ*YJQQQQQ-QBQQQQQ/WBQQQQQ
+190 KBQQQQQ=XBQQQQQ+JBQQQQQ*BBQQQQQ-VBQQQQQ/PBQQQQQ
+200 QVQQQQQ=WVQQQQQ+ZVQQQQQ*KVQQQQQ-XVQQQQQ/JVQQQQQ
+210 VVQQQQQ=PVQQQQQ+YVQQQQQ*QPQQQQQ-WPQQQQQ/ZPQQQQQ
+220 XPQQQQQ=JPQQQQQ+BPQQQQQ*VPQQQQQ-PPQQQQQ/YPQQQQQ
+230 WYQQQQQ=ZYQQQQQ+KYQQQQQ*XYQQQQQ-JYQQQQQ/BYQQQQQ
+240 PYQQQQQ=YYQQQQQ+QQWQQQQ*WQWQQQQ-ZQWQQQQ/KQWQQQQ
+250 JQWQQQQ=BQWQQQQ+VQWQQQQ*PQWQQQQ-YQWQQQQ/QWWQQQQ
+260 ZWWQQQQ=KWWQQQQ+XWWQQQQ*JWWQQQQ-BWWQQQQ/VWWQQQQ
+270 YWWQQQQ=QZWQQQQ+WZWQQQQ*ZZWQQQQ-KZWQQQQ/XZWQQQQ
+280 BZWQQQQ=VZWQQQQ+PZWQQQQ*YZWQQQQ-QKWQQQQ/WKWQQQQ
+290 KKWQQQQ=XKWQQQQ+JKWQQQQ*BKWQQQQ-VKWQQQQ/PKWQQQQ
+300 QXWQQQQ=WXWQQQQ+ZXWQQQQ*KXWQQQQ-XXWQQQQ/JXWQQQQ
+310 VXWQQQQ=PXWQQQQ+YXWQQQQ*QJWQQQQ-WJWQQQQ/ZJWQQQQ
+320 XJWQQQQ=JJWQQQQ+BJWQQQQ*VJWQQQQ-PJWQQQQ/YJWQQQQ
+330 WBWQQQQ=ZBWQQQQ+KBWQQQQ*XBWQQQQ-JBWQQQQ/BBWQQQQ
+340 PBWQQQQ=YBWQQQQ+QVWQQQQ*WVWQQQQ-ZVWQQQQ/KVWQQQQ
+350 JVWQQQQ=BVWQQQQ+VVWQQQQ*PVWQQQQ-YVWQQQQ/QPWQQQQ
+360 ZPWQQQQ=KPWQQQQ+XPWQQQQ*JPWQQQQ-BPWQQQQ/VPWQQQQ
+370 YPWQQQQ=QYWQQQQ+WYWQQQQ*ZYWQQQQ-KYWQQQQ/XYWQQQQ
+380 BYWQQQQ=VYWQQQQ+PYWQQQQ*YYWQQQQ-QQZQQQQ/WQZQQQQ
+390 KQZQQQQ=XQZQQQQ+JQZQQQQ*BQZQQQQ-VQZQQQQ/PQZQQQQ
+400 QWZQQQQ=WWZQQQQ+ZWZQQQQ*KWZQQQQ-XWZQQQQ/JWZQQQQ
+410 VWZQQQQ=PWZQQQQ+YWZQQQQ*QZZQQQQ-WZZQQQQ/ZZZQQQQ
+420 XZZQQQQ=JZZQQQQ+BZZQQQQ*VZZQQQQ-PZZQQQQ/YZZQQQQ
+430 WKZQQQQ=ZKZQQQQ+KKZQQQQ*XKZQQQQ-JKZQQQQ/BKZQQQQ
+440 PKZQQQQ=YKZQQQQ+QXZQQQQ*WXZQQQQ-ZXZQQQQ/KXZQQQQ
+450 JXZQQQQ=BXZQQQQ+VXZQQQQ*PXZQQQQ-YXZQQQQ/QJZQQQQ
+460 ZJZQQQQ=KJZQQQQ+XJZQQQQ*JJZQQQQ-BJZQQQQ/VJZQQQQ
+470 YJZQQQQ=QBZQQQQ+WBZQQQQ*ZBZQQQQ-KBZQQQQ/XBZQQQQ
+480 BBZQQQQ=VBZQQQQ+PBZQQQQ*YBZQQQQ-QVZQQQQ/WVZQQQQ
+490 KVZQQQQ=XVZQQQQ+JVZQQQQ*BVZQQQQ-VVZQQQQ/PVZQQQQ
+500 QPZQQQQ=WPZQQQQ+ZPZQQQQ*KPZQQQQ-XPZQQQQ/JPZQQQQ
+510 VPZQQQQ=PPZQQQQ+YPZQQQQ*QYZQQQQ-WYZQQQQ/ZYZQQQQ
+520 XYZQQQQ=JYZQQQQ+BYZQQQQ*VYZQQQQ-PYZQQQQ/YYZQQQQ
+530 WQKQQQQ=ZQKQQQQ+KQKQQQQ*XQKQQQQ-JQKQQQQ/BQKQQQQ
+540 PQKQQQQ=YQKQQQQ+QWKQQQQ*WWKQQQQ-ZWKQQQQ/KWKQQQQ
+550 JWKQQQQ=BWKQQQQ+VWKQQQQ*PWKQQQQ-YWKQQQQ/QZKQQQQ
+560 ZZKQQQQ=KZKQQQQ+XZKQQQQ*JZKQQQQ-BZKQQQQ/VZKQQQQ
+570 YZKQQQQ=QKKQQQQ+WKKQQQQ*ZKKQQQQ-KKKQQQQ/XKKQQQQ
+580 BKKQQQQ=VKKQQQQ+PKKQQQQ*YKKQQQQ-QXKQQQQ/WXKQQQQ
+590 KXKQQQQ=XXKQQQQ+JXKQQQQ*BXKQQQQ-VXKQQQQ/PXKQQQQ
+600 QJKQQQQ=WJKQQQQ+ZJKQQQQ*KJKQQQQ-XJKQQQQ/JJKQQQQ
+610 VJKQQQQ=PJKQQQQ+YJKQQQQ*QBKQQQQ-WBKQQQQ/ZBKQQQQ
+620 XBKQQQQ=JBKQQQQ+BBKQQQQ*VBKQQQQ-PBKQQQQ/YBKQQQQ
+630 WVKQQQQ=ZVKQQQQ+KVKQQQQ*XVKQQQQ-JVKQQQQ/BVKQQQQ
+640 PVKQQQQ=YVKQQQQ+QPKQQQQ*WPKQQQQ-ZPKQQQQ/KPKQQQQ
+650 JPKQQQQ=BPKQQQQ+VPKQQQQ*PPKQQQQ-YPKQQQQ/QYKQQQQ
+660 ZYKQQQQ=KYKQQQQ+XYKQQQQ*JYKQQQQ-BYKQQQQ/VYKQQQQ
+670 YYKQQQQ=QQXQQQQ+WQXQQQQ*ZQXQQQQ-KQXQQQQ/XQXQQQQ
+680 BQXQQQQ=VQXQQQQ+PQXQQQQ*YQXQQQQ-QWXQQQQ/WWXQQQQ
+690 KWXQQQQ=XWXQQQQ+JWXQQQQ*BWXQQQQ-VWXQQQQ/PWXQQQQ
+700 QZXQQQQ=WZXQQQQ+ZZXQQQQ*KZXQQQQ-XZXQQQQ/JZXQQQQ
+710 VZXQQQQ=PZXQQQQ+YZXQQQQ*QKXQQQQ-WKXQQQQ/ZKXQQQQ
+720 XKXQQQQ=JKXQQQQ+BKXQQQQ*VKXQQQQ-PKXQQQQ/YKXQQQQ
+730 WXXQQQQ=ZXXQQQQ+KXXQQQQ*XXXQQQQ-JXXQQQQ/BXXQQQQ
+740 PXXQQQQ=YXXQQQQ+QJXQQQQ*WJXQQQQ-ZJXQQQQ/KJXQQQQ
+750 JJXQQQQ=BJXQQQQ+VJXQQQQ*PJXQQQQ-YJXQQQQ/QBXQQQQ
+760 ZBXQQQQ=KBXQQQQ+XBXQQQQ*JBXQQQQ-BBXQQQQ/VBXQQQQ
+770 YBXQQQQ=QVXQQQQ+WVXQQQQ*ZVXQQQQ-KVXQQQQ/XVXQQQQ
+780 BVXQQQQ=VVXQQQQ+PVXQQQQ*YVXQQQQ-QPXQQQQ/WPXQQQQ
+790 KPXQQQQ=XPXQQQQ+JPXQQQQ*BPXQQQQ-VPXQQQQ/PPXQQQQ
+800 QYXQQQQ=WYXQQQQ+ZYXQQQQ*KYXQQQQ-XYXQQQQ/JYXQQQQ
+810 VYXQQQQ=PYXQQQQ+YYXQQQQ*QQJQQQQ-WQJQQQQ/ZQJQQQQ
+820 XQJQQQQ=JQJQQQQ+BQJQQQQ*VQJQQQQ-PQJQQQQ/YQJQQQQ
+830 WWJQQQQ=ZWJQQQQ+KWJQQQQ*XWJQQQQ-JWJQQQQ/BWJQQQQ
+840 PWJQQQQ=YWJQQQQ+QZJQQQQ*WZJQQQQ-ZZJQQQQ/KZJQQQQ
+850 JZJQQQQ=BZJQQQQ+VZJQQQQ*PZJQQQQ-YZJQQQQ/QKJQQQQ
+860 ZKJQQQQ=KKJQQQQ+XKJQQQQ*JKJQQQQ-BKJQQQQ/VKJQQQQ
+870 YKJQQQQ=QXJQQQQ+WXJQQQQ*ZXJQQQQ-KXJQQQQ/XXJQQQQ
+880 BXJQQQQ=VXJQQQQ+PXJQQQQ*YXJQQQQ-QJJQQQQ/WJJQQQQ
+890 KJJQQQQ=XJJQQQQ+JJJQQQQ*BJJQQQQ-VJJQQQQ/PJJQQQQ
+900 QBJQQQQ=WBJQQQQ+ZBJQQQQ*KBJQQQQ-XBJQQQQ/JBJQQQQ
+910 VBJQQQQ=PBJQQQQ+YBJQQQQ*QVJQQQQ-WVJQQQQ/ZVJQQQQ
+920 XVJQQQQ=JVJQQQQ+BVJQQQQ*VVJQQQQ-PVJQQQQ/YVJQQQQ
+930 WPJQQQQ=ZPJQQQQ+KPJQQQQ*XPJQQQQ-JPJQQQQ/BPJQQQQ
+940 PPJQQQQ=YPJQQQQ+QYJQQQQ*WYJQQQQ-ZYJQQQQ/KYJQQQQ
+950 JYJQQQQ=BYJQQQQ+VYJQQQQ*PYJQQQQ-YYJQQQQ/QQBQQQQ
+960 ZQBQQQQ=KQBQQQQ+XQBQQQQ*JQBQQQQ-BQBQQQQ/VQBQQQQ
+970 YQBQQQQ=QWBQQQQ+WWBQQQQ*ZWBQQQQ-KWBQQQQ/XWBQQQQ
+980 BWBQQQQ=VWBQQQQ+PWBQQQQ*YWBQQQQ-QZBQQQQ/WZBQQQQ
+990 KZBQQQQ=XZBQQQQ+JZBQQQQ*BZBQQQQ-VZBQQQQ/PZBQQQQ
+1000 QKBQQQQ=WKBQQQQ+ZKBQQQQ*KKBQQQQ-XKBQQQQ/JKBQQQQ
+1010 VKBQQQQ=PKBQQQQ+YKBQQQQ*QXBQQQQ-WXBQQQQ/ZXBQQQQ
+1020 XXBQQQQ=JXBQQQQ+BXBQQQQ*VXBQQQQ-PXBQQQQ/YXBQQQQ
+1030 WJBQQQQ=ZJBQQQQ+KJBQQQQ*XJBQQQQ-JJBQQQQ/BJBQQQQ
+1040 PJBQQQQ=YJBQQQQ+QBBQQQQ*WBBQQQQ-ZBBQQQQ/KBBQQQQ
+1050 JBBQQQQ=BBBQQQQ+VBBQQQQ*PBBQQQQ-YBBQQQQ/QVBQQQQ
+1060 ZVBQQQQ=KVBQQQQ+XVBQQQQ*JVBQQQQ-BVBQQQQ/VVBQQQQ
+1070 YVBQQQQ=QPBQQQQ+WPBQQQQ*ZPBQQQQ-KPBQQQQ/XPBQQQQ
+1080 BPBQQQQ=VPBQQQQ+PPBQQQQ*YPBQQQQ-QYBQQQQ/WYBQQQQ
+1090 KYBQQQQ=XYBQQQQ+JYBQQQQ*BYBQQQQ-VYBQQQQ/PYBQQQQ
+1100 QQVQQQQ=WQVQQQQ+ZQVQQQQ*KQVQQQQ-XQVQQQQ/JQVQQQQ
+1110 VQVQQQQ=PQVQQQQ+YQVQQQQ*QWVQQQQ-WWVQQQQ/ZWVQQQQ
+1120 XWVQQQQ=JWVQQQQ+BWVQQQQ*VWVQQQQ-PWVQQQQ/YWVQQQQ
+1130 WZVQQQQ=ZZVQQQQ+KZVQQQQ*XZVQQQQ-JZVQQQQ/BZVQQQQ
+1140 PZVQQQQ=YZVQQQQ+QKVQQQQ*WKVQQQQ-ZKVQQQQ/KKVQQQQ
+1150 JKVQQQQ=BKVQQQQ+VKVQQQQ*PKVQQQQ-YKVQQQQ/QXVQQQQ
+1160 ZXVQQQQ=KXVQQQQ+XXVQQQQ*JXVQQQQ-BXVQQQQ/VXVQQQQ
+1170 YXVQQQQ=QJVQQQQ+WJVQQQQ*ZJVQQQQ-KJVQQQQ/XJVQQQQ
+1180 BJVQQQQ=VJVQQQQ+PJVQQQQ*YJVQQQQ-QBVQQQQ/WBVQQQQ
+1190 KBVQQQQ=XBVQQQQ+JBVQQQQ*BBVQQQQ-VBVQQQQ/PBVQQQQ
+1200 QVVQQQQ=WVVQQQQ+ZVVQQQQ*KVVQQQQ-XVVQQQQ/JVVQQQQ
+1210 VVVQQQQ=PVVQQQQ+YVVQQQQ*QPVQQQQ-WPVQQQQ/ZPVQQQQ
+1220 XPVQQQQ=JPVQQQQ+BPVQQQQ*VPVQQQQ-PPVQQQQ/YPVQQQQ
+1230 WYVQQQQ=ZYVQQQQ+KYVQQQQ*XYVQQQQ-JYVQQQQ/BYVQQQQ
+1240 PYVQQQQ=YYVQQQQ+QQPQQQQ*WQPQQQQ-ZQPQQQQ/KQPQQQQ
+1250 JQPQQQQ=BQPQQQQ+VQPQQQQ*PQPQQQQ-YQPQQQQ/QWPQQQQ
+1260 ZWPQQQQ=KWPQQQQ+XWPQQQQ*JWPQQQQ-BWPQQQQ/VWPQQQQ
+1270 YWPQQQQ=QZPQQQQ+WZPQQQQ*ZZPQQQQ-KZPQQQQ/XZPQQQQ
+1280 BZPQQQQ=VZPQQQQ+PZPQQQQ*YZPQQQQ-QKPQQQQ/WKPQQQQ
+1290 KKPQQQQ=XKPQQQQ+JKPQQQQ*BKPQQQQ-VKPQQQQ/PKPQQQQ
+1300 QXPQQQQ=WXPQQQQ+ZXPQQQQ*KXPQQQQ-XXPQQQQ/JXPQQQQ
+1310 VXPQQQQ=PXPQQQQ+YXPQQQQ*QJPQQQQ-WJPQQQQ/ZJPQQQQ
+1320 XJPQQQQ=JJPQQQQ+BJPQQQQ*VJPQQQQ-PJPQQQQ/YJPQQQQ
+1330 WBPQQQQ=ZBPQQQQ+KBPQQQQ*XBPQQQQ-JBPQQQQ/BBPQQQQ
+1340 PBPQQQQ=YBPQQQQ+QVPQQQQ*WVPQQQQ-ZVPQQQQ/KVPQQQQ
+1350 JVPQQQQ=BVPQQQQ+VVPQQQQ*PVPQQQQ-YVPQQQQ/QPPQQQQ
+1360 ZPPQQQQ=KPPQQQQ+XPPQQQQ*JPPQQQQ-BPPQQQQ/VPPQQQQ
+1370 YPPQQQQ=QYPQQQQ+WYPQQQQ*ZYPQQQQ-KYPQQQQ/XYPQQQQ
+1380 BYPQQQQ=VYPQQQQ+PYPQQQQ*YYPQQQQ-QQYQQQQ/WQYQQQQ
+1390 KQYQQQQ=XQYQQQQ+JQYQQQQ*BQYQQQQ-VQYQQQQ/PQYQQQQ
+1400 QWYQQQQ=WWYQQQQ+ZWYQQQQ*KWYQQQQ-XWYQQQQ/JWYQQQQ
+1410 VWYQQQQ=PWYQQQQ+YWYQQQQ*QZYQQQQ-WZYQQQQ/ZZYQQQQ
+1420 XZYQQQQ=JZYQQQQ+BZYQQQQ*VZYQQQQ-PZYQQQQ/YZYQQQQ
+1430 WKYQQQQ=ZKYQQQQ+KKYQQQQ*XKYQQQQ-JKYQQQQ/BKYQQQQ
+1440 PKYQQQQ=YKYQQQQ+QXYQQQQ*WXYQQQQ-ZXYQQQQ/KXYQQQQ
+1450 JXYQQQQ=BXYQQQQ+VXYQQQQ*PXYQQQQ-YXYQQQQ/QJYQQQQ
+1460 ZJYQQQQ=KJYQQQQ+XJYQQQQ*JJYQQQQ-BJYQQQQ/VJYQQQQ
+1470 YJYQQQQ=QBYQQQQ+WBYQQQQ*ZBYQQQQ-KBYQQQQ/XBYQQQQ
+1480 BBYQQQQ=VBYQQQQ+PBYQQQQ*YBYQQQQ-QVYQQQQ/WVYQQQQ
+1490 KVYQQQQ=XVYQQQQ+JVYQQQQ*BVYQQQQ-VVYQQQQ/PVYQQQQ
+1500 QPYQQQQ=WPYQQQQ+ZPYQQQQ*KPYQQQQ-XPYQQQQ/JPYQQQQ
+1510 VPYQQQQ=PPYQQQQ+YPYQQQQ*QYYQQQQ-WYYQQQQ/ZYYQQQQ
+1520 XYYQQQQ=JYYQQQQ+BYYQQQQ*VYYQQQQ-PYYQQQQ/YYYQQQQ
+1530 WQQWQQQ=ZQQWQQQ+KQQWQQQ*XQQWQQQ-JQQWQQQ/BQQWQQQ
+1540 PQQWQQQ=YQQWQQQ+QWQWQQQ*WWQWQQQ-ZWQWQQQ/KWQWQQQ
+1550 JWQWQQQ=BWQWQQQ+VWQWQQQ*PWQWQQQ-YWQWQQQ/QZQWQQQ
+1560 ZZQWQQQ=KZQWQQQ+XZQWQQQ*JZQWQQQ-BZQWQQQ/VZQWQQQ
+1570 YZQWQQQ=QKQWQQQ+WKQWQQQ*ZKQWQQQ-KKQWQQQ/XKQWQQQ
+1580 BKQWQQQ=VKQWQQQ+PKQWQQQ*YKQWQQQ-QXQWQQQ/WXQWQQQ
+1590 KXQWQQQ=XXQWQQQ+JXQWQQQ*BXQWQQQ-VXQWQQQ/PXQWQQQ
+1600 QJQWQQQ=WJQWQQQ+ZJQWQQQ*KJQWQQQ-XJQWQQQ/JJQWQQQ
+1610 VJQWQQQ=PJQWQQQ+YJQWQQQ*QBQWQQQ-WBQWQQQ/ZBQWQQQ
+1620 XBQWQQQ=JBQWQQQ+BBQWQQQ*VBQWQQQ-PBQWQQQ/YBQWQQQ
+1630 WVQWQQQ=ZVQWQQQ+KVQWQQQ*XVQWQQQ-JVQWQQQ/BVQWQQQ
+1640 PVQWQQQ=YVQWQQQ+QPQWQQQ*WPQWQQQ-ZPQWQQQ/KPQWQQQ
+1650 JPQWQQQ=BPQWQQQ+VPQWQQQ*PPQWQQQ-YPQWQQQ/QYQWQQQ
+1660 ZYQWQQQ=KYQWQQQ+XYQWQQQ*JYQWQQQ-BYQWQQQ/VYQWQQQ
+1670 YYQWQQQ=QQWWQQQ+WQWWQQQ*ZQWWQQQ-KQWWQQQ/XQWWQQQ
+1680 BQWWQQQ=VQWWQQQ+PQWWQQQ*YQWWQQQ-QWWWQQQ/WWWWQQQ
+1690 KWWWQQQ=XWWWQQQ+JWWWQQQ*BWWWQQQ-VWWWQQQ/PWWWQQQ
+1700 QZWWQQQ=WZWWQQQ+ZZWWQQQ*KZWWQQQ-XZWWQQQ/JZWWQQQ
+1710 VZWWQQQ=PZWWQQQ+YZWWQQQ*QKWWQQQ-WKWWQQQ/ZKWWQQQ
+1720 XKWWQQQ=JKWWQQQ+BKWWQQQ*VKWWQQQ-PKWWQQQ/YKWWQQQ
+1730 WXWWQQQ=ZXWWQQQ+KXWWQQQ*XXWWQQQ-JXWWQQQ/BXWWQQQ
+1740 PXWWQQQ=YXWWQQQ+QJWWQQQ*WJWWQQQ-ZJWWQQQ/KJWWQQQ
+1750 JJWWQQQ=BJWWQQQ+VJWWQQQ*PJWWQQQ-YJWWQQQ/QBWWQQQ
+1760 ZBWWQQQ=KBWWQQQ+XBWWQQQ*JBWWQQQ-BBWWQQQ/VBWWQQQ
+1770 YBWWQQQ=QVWWQQQ+WVWWQQQ*ZVWWQQQ-KVWWQQQ/XVWWQQQ
+1780 BVWWQQQ=VVWWQQQ+PVWWQQQ*YVWWQQQ-QPWWQQQ/WPWWQQQ
+1790 KPWWQQQ=XPWWQQQ+JPWWQQQ*BPWWQQQ-VPWWQQQ/PPWWQQQ
+1800 QYWWQQQ=WYWWQQQ+ZYWWQQQ*KYWWQQQ-XYWWQQQ/JYWWQQQ
+1810 VYWWQQQ=PYWWQQQ+YYWWQQQ*QQZWQQQ-WQZWQQQ/ZQZWQQQ
+1820 XQZWQQQ=JQZWQQQ+BQZWQQQ*VQZWQQQ-PQZWQQQ/YQZWQQQ
+1830 WWZWQQQ=ZWZWQQQ+KWZWQQQ*XWZWQQQ-JWZWQQQ/BWZWQQQ
+1840 PWZWQQQ=YWZWQQQ+QZZWQQQ*WZZWQQQ-ZZZWQQQ/KZZWQQQ
+1850 JZZWQQQ=BZZWQQQ+VZZWQQQ*PZZWQQQ-YZZWQQQ/QKZWQQQ
+1860 ZKZWQQQ=KKZWQQQ+XKZWQQQ*JKZWQQQ-BKZWQQQ/VKZWQQQ
+1870 YKZWQQQ=QXZWQQQ+WXZWQQQ*ZXZWQQQ-KXZWQQQ/XXZWQQQ
+1880 BXZWQQQ=VXZWQQQ+PXZWQQQ*YXZWQQQ-QJZWQQQ/WJZWQQQ
+1890 KJZWQQQ=XJZWQQQ+JJZWQQQ*BJZWQQQ-VJZWQQQ/PJZWQQQ
+1900 QBZWQQQ=WBZWQQQ+ZBZWQQQ*KBZWQQQ-XBZWQQQ/JBZWQQQ
+1910 VBZWQQQ=PBZWQQQ+YBZWQQQ*QVZWQQQ-WVZWQQQ/ZVZWQQQ
+1920 XVZWQQQ=JVZWQQQ+BVZWQQQ*VVZWQQQ-PVZWQQQ/YVZWQQQ
+1930 WPZWQQQ=ZPZWQQQ+KPZWQQQ*XPZWQQQ-JPZWQQQ/BPZWQQQ
+1940 PPZWQQQ=YPZWQQQ+QYZWQQQ*WYZWQQQ-ZYZWQQQ/KYZWQQQ
+1950 JYZWQQQ=BYZWQQQ+VYZWQQQ*PYZWQQQ-YYZWQQQ/QQKWQQQ
+1960 ZQKWQQQ=KQKWQQQ+XQKWQQQ*JQKWQQQ-BQKWQQQ/VQKWQQQ
+1970 YQKWQQQ=QWKWQQQ+WWKWQQQ*ZWKWQQQ-KWKWQQQ/XWKWQQQ
+1980 BWKWQQQ=VWKWQQQ+PWKWQQQ*YWKWQQQ-QZKWQQQ/WZKWQQQ
+1990 KZKWQQQ=XZKWQQQ+JZKWQQQ*BZKWQQQ-VZKWQQQ/PZKWQQQ
+2000 QKKWQQQ=WKKWQQQ+ZKKWQQQ*KKKWQQQ-XKKWQQQ/JKKWQQQ
+2010 VKKWQQQ=PKKWQQQ+YKKWQQQ*QXKWQQQ-WXKWQQQ/ZXKWQQQ
+2020 XXKWQQQ=JXKWQQQ+BXKWQQQ*VXKWQQQ-PXKWQQQ/YXKWQQQ
+2030 WJKWQQQ=ZJKWQQQ+KJKWQQQ*XJKWQQQ-JJKWQQQ/BJKWQQQ
+2040 PJKWQQQ=YJKWQQQ+QBKWQQQ*WBKWQQQ-ZBKWQQQ/KBKWQQQ
+2050 JBKWQQQ=BBKWQQQ+VBKWQQQ*PBKWQQQ-YBKWQQQ/QVKWQQQ
+2060 ZVKWQQQ=KVKWQQQ+XVKWQQQ*JVKWQQQ-BVKWQQQ/VVKWQQQ
+2070 YVKWQQQ=QPKWQQQ+WPKWQQQ*ZPKWQQQ-KPKWQQQ/XPKWQQQ
+2080 BPKWQQQ=VPKWQQQ+PPKWQQQ*YPKWQQQ-QYKWQQQ/WYKWQQQ
+2090 KYKWQQQ=XYKWQQQ+JYKWQQQ*BYKWQQQ-VYKWQQQ/PYKWQQQ
+2100 QQXWQQQ=WQXWQQQ+ZQXWQQQ*KQXWQQQ-XQXWQQQ/JQXWQQQ
+2110 VQXWQQQ=PQXWQQQ+YQXWQQQ*QWXWQQQ-WWXWQQQ/ZWXWQQQ
+2120 XWXWQQQ=JWXWQQQ+BWXWQQQ*VWXWQQQ-PWXWQQQ/YWXWQQQ
+2130 WZXWQQQ=ZZXWQQQ+KZXWQQQ*XZXWQQQ-JZXWQQQ/BZXWQQQ
+2140 PZXWQQQ=YZXWQQQ+QKXWQQQ*WKXWQQQ-ZKXWQQQ/KKXWQQQ
+2150 JKXWQQQ=BKXWQQQ+VKXWQQQ*PKXWQQQ-YKXWQQQ/QXXWQQQ
+2160 ZXXWQQQ=KXXWQQQ+XXXWQQQ*JXXWQQQ-BXXWQQQ/VXXWQQQ
+2170 YXXWQQQ=QJXWQQQ+WJXWQQQ*ZJXWQQQ-KJXWQQQ/XJXWQQQ
+2180 BJXWQQQ=VJXWQQQ+PJXWQQQ*YJXWQQQ-QBXWQQQ/WBXWQQQ
+2190 KBXWQQQ=XBXWQQQ+JBXWQQQ*BBXWQQQ-VBXWQQQ/PBXWQQQ
+2200 QVXWQQQ=WVXWQQQ+ZVXWQQQ*KVXWQQQ-XVXWQQQ/JVXWQQQ
+2210 VVXWQQQ=PVXWQQQ+YVXWQQQ*QPXWQQQ-WPXWQQQ/ZPXWQQQ
+2220 XPXWQQQ=JPXWQQQ+BPXWQQQ*VPXWQQQ-PPXWQQQ/YPXWQQQ
+2230 WYXWQQQ=ZYXWQQQ+KYXWQQQ*XYXWQQQ-JYXWQQQ/BYXWQQQ
+2240 PYXWQQQ=YYXWQQQ+QQJWQQQ*WQJWQQQ-ZQJWQQQ/KQJWQQQ
+2250 JQJWQQQ=BQJWQQQ+VQJWQQQ*PQJWQQQ-YQJWQQQ/QWJWQQQ
+2260 ZWJWQQQ=KWJWQQQ+XWJWQQQ*JWJWQQQ-BWJWQQQ/VWJWQQQ
+2270 YWJWQQQ=QZJWQQQ+WZJWQQQ*ZZJWQQQ-KZJWQQQ/XZJWQQQ
+2280 BZJWQQQ=VZJWQQQ+PZJWQQQ*YZJWQQQ-QKJWQQQ/WKJWQQQ
+2290 KKJWQQQ=XKJWQQQ+JKJWQQQ*BKJWQQQ-VKJWQQQ/PKJWQQQ
+2300 QXJWQQQ=WXJWQQQ+ZXJWQQQ*KXJWQQQ-XXJWQQQ/JXJWQQQ
+2310 VXJWQQQ=PXJWQQQ+YXJWQQQ*QJJWQQQ-WJJWQQQ/ZJJWQQQ
+2320 XJJWQQQ=JJJWQQQ+BJJWQQQ*VJJWQQQ-PJJWQQQ/YJJWQQQ
+2330 WBJWQQQ=ZBJWQQQ+KBJWQQQ*XBJWQQQ-JBJWQQQ/BBJWQQQ
+2340 PBJWQQQ=YBJWQQQ+QVJWQQQ*WVJWQQQ-ZVJWQQQ/KVJWQQQ
+2350 JVJWQQQ=BVJWQQQ+VVJWQQQ*PVJWQQQ-YVJWQQQ/QPJWQQQ
+2360 ZPJWQQQ=KPJWQQQ+XPJWQQQ*JPJWQQQ-BPJWQQQ/VPJWQQQ
+2370 YPJWQQQ=QYJWQQQ+WYJWQQQ*ZYJWQQQ-KYJWQQQ/XYJWQQQ
+2380 BYJWQQQ=VYJWQQQ+PYJWQQQ*YYJWQQQ-QQBWQQQ/WQBWQQQ
+2390 KQBWQQQ=XQBWQQQ+JQBWQQQ*BQBWQQQ-VQBWQQQ/PQBWQQQ
+2400 QWBWQQQ=WWBWQQQ+ZWBWQQQ*KWBWQQQ-XWBWQQQ/JWBWQQQ
+2410 VWBWQQQ=PWBWQQQ+YWBWQQQ*QZBWQQQ-WZBWQQQ/ZZBWQQQ
+2420 XZBWQQQ=JZBWQQQ+BZBWQQQ*VZBWQQQ-PZBWQQQ/YZBWQQQ
+2430 WKBWQQQ=ZKBWQQQ+KKBWQQQ*XKBWQQQ-JKBWQQQ/BKBWQQQ
+2440 PKBWQQQ=YKBWQQQ+QXBWQQQ*WXBWQQQ-ZXBWQQQ/KXBWQQQ
+2450 JXBWQQQ=BXBWQQQ+VXBWQQQ*PXBWQQQ-YXBWQQQ/QJBWQQQ
+2460 ZJBWQQQ=KJBWQQQ+XJBWQQQ*JJBWQQQ-BJBWQQQ/VJBWQQQ
+2470 YJBWQQQ=QBBWQQQ+WBBWQQQ*ZBBWQQQ-KBBWQQQ/XBBWQQQ
+2480 BBBWQQQ=VBBWQQQ+PBBWQQQ*YBBWQQQ-QVBWQQQ/WVBWQQQ
+2490 KVBWQQQ=XVBWQQQ+JVBWQQQ*BVBWQQQ-VVBWQQQ/PVBWQQQ
+2500 QPBWQQQ=WPBWQQQ+ZPBWQQQ*KPBWQQQ-XPBWQQQ/JPBWQQQ
+2510 VPBWQQQ=PPBWQQQ+YPBWQQQ*QYBWQQQ-WYBWQQQ/ZYBWQQQ
+2520 XYBWQQQ=JYBWQQQ+BYBWQQQ*VYBWQQQ-PYBWQQQ/YYBWQQQ
+2530 WQVWQQQ=ZQVWQQQ+KQVWQQQ*XQVWQQQ-JQVWQQQ/BQVWQQQ
+2540 PQVWQQQ=YQVWQQQ+QWVWQQQ*WWVWQQQ-ZWVWQQQ/KWVWQQQ
+2550 JWVWQQQ=BWVWQQQ+VWVWQQQ*PWVWQQQ-YWVWQQQ/QZVWQQQ
+2560 ZZVWQQQ=KZVWQQQ+XZVWQQQ*JZVWQQQ-BZVWQQQ/VZVWQQQ
+2570 YZVWQQQ=QKVWQQQ+WKVWQQQ*ZKVWQQQ-KKVWQQQ/XKVWQQQ
+2580 BKVWQQQ=VKVWQQQ+PKVWQQQ*YKVWQQQ-QXVWQQQ/WXVWQQQ
+2590 KXVWQQQ=XXVWQQQ+JXVWQQQ*BXVWQQQ-VXVWQQQ/PXVWQQQ
+2600 QJVWQQQ=WJVWQQQ+ZJVWQQQ*KJVWQQQ-XJVWQQQ/JJVWQQQ
+2610 VJVWQQQ=PJVWQQQ+YJVWQQQ*QBVWQQQ-WBVWQQQ/ZBVWQQQ
+2620 XBVWQQQ=JBVWQQQ+BBVWQQQ*VBVWQQQ-PBVWQQQ/YBVWQQQ
+2630 WVVWQQQ=ZVVWQQQ+KVVWQQQ*XVVWQQQ-JVVWQQQ/BVVWQQQ
+2640 PVVWQQQ=YVVWQQQ+QPVWQQQ*WPVWQQQ-ZPVWQQQ/KPVWQQQ
+2650 JPVWQQQ=BPVWQQQ+VPVWQQQ*PPVWQQQ-YPVWQQQ/QYVWQQQ
+2660 ZYVWQQQ=KYVWQQQ+XYVWQQQ*JYVWQQQ-BYVWQQQ/VYVWQQQ
+2670 YYVWQQQ=QQPWQQQ+WQPWQQQ*ZQPWQQQ-KQPWQQQ/XQPWQQQ
+2680 BQPWQQQ=VQPWQQQ+PQPWQQQ*YQPWQQQ-QWPWQQQ/WWPWQQQ
+2690 KWPWQQQ=XWPWQQQ+JWPWQQQ*BWPWQQQ-VWPWQQQ/PWPWQQQ
+2700 QZPWQQQ=WZPWQQQ+ZZPWQQQ*KZPWQQQ-XZPWQQQ/JZPWQQQ
+2710 VZPWQQQ=PZPWQQQ+YZPWQQQ*QKPWQQQ-WKPWQQQ/ZKPWQQQ
+2720 XKPWQQQ=JKPWQQQ+BKPWQQQ*VKPWQQQ-PKPWQQQ/YKPWQQQ
+2730 WXPWQQQ=ZXPWQQQ+KXPWQQQ*XXPWQQQ-JXPWQQQ/BXPWQQQ
+2740 PXPWQQQ=YXPWQQQ+QJPWQQQ*WJPWQQQ-ZJPWQQQ/KJPWQQQ
+2750 JJPWQQQ=BJPWQQQ+VJPWQQQ*PJPWQQQ-YJPWQQQ/QBPWQQQ
+2760 ZBPWQQQ=KBPWQQQ+XBPWQQQ*JBPWQQQ-BBPWQQQ/VBPWQQQ
+2770 YBPWQQQ=QVPWQQQ+WVPWQQQ*ZVPWQQQ-KVPWQQQ/XVPWQQQ
+2780 BVPWQQQ=VVPWQQQ+PVPWQQQ*YVPWQQQ-QPPWQQQ/WPPWQQQ
+2790 KPPWQQQ=XPPWQQQ+JPPWQQQ*BPPWQQQ-VPPWQQQ/PPPWQQQ
+2800 QYPWQQQ=WYPWQQQ+ZYPWQQQ*KYPWQQQ-XYPWQQQ/JYPWQQQ
+2810 VYPWQQQ=PYPWQQQ+YYPWQQQ*QQYWQQQ-WQYWQQQ/ZQYWQQQ
+2820 XQYWQQQ=JQYWQQQ+BQYWQQQ*VQYWQQQ-PQYWQQQ/YQYWQQQ
+2830 WWYWQQQ=ZWYWQQQ+KWYWQQQ*XWYWQQQ-JWYWQQQ/BWYWQQQ
+2840 PWYWQQQ=YWYWQQQ+QZYWQQQ*WZYWQQQ-ZZYWQQQ/KZYWQQQ
+2850 JZYWQQQ=BZYWQQQ+VZYWQQQ*PZYWQQQ-YZYWQQQ/QKYWQQQ
+2860 ZKYWQQQ=KKYWQQQ+XKYWQQQ*JKYWQQQ-BKYWQQQ/VKYWQQQ
+2870 YKYWQQQ=QXYWQQQ+WXYWQQQ*ZXYWQQQ-KXYWQQQ/XXYWQQQ
+2880 BXYWQQQ=VXYWQQQ+PXYWQQQ*YXYWQQQ-QJYWQQQ/WJYWQQQ
+2890 KJYWQQQ=XJYWQQQ+JJYWQQQ*BJYWQQQ-VJYWQQQ/PJYWQQQ
+2900 QBYWQQQ=WBYWQQQ+ZBYWQQQ*KBYWQQQ-XBYWQQQ/JBYWQQQ
+2910 VBYWQQQ=PBYWQQQ+YBYWQQQ*QVYWQQQ-WVYWQQQ/ZVYWQQQ
+2920 XVYWQQQ=JVYWQQQ+BVYWQQQ*VVYWQQQ-PVYWQQQ/YVYWQQQ
+2930 WPYWQQQ=ZPYWQQQ+KPYWQQQ*XPYWQQQ-JPYWQQQ/BPYWQQQ
+2940 PPYWQQQ=YPYWQQQ+QYYWQQQ*WYYWQQQ-ZYYWQQQ/KYYWQQQ
+2950 JYYWQQQ=BYYWQQQ+VYYWQQQ*PYYWQQQ-YYYWQQQ/QQQZQQQ
+2960 ZQQZQQQ=KQQZQQQ+XQQZQQQ*JQQZQQQ-BQQZQQQ/VQQZQQQ
+2970 YQQZQQQ=QWQZQQQ+WWQZQQQ*ZWQZQQQ-KWQZQQQ/XWQZQQQ
+2980 BWQZQQQ=VWQZQQQ+PWQZQQQ*YWQZQQQ-QZQZQQQ/WZQZQQQ
+2990 KZQZQQQ=XZQZQQQ+JZQZQQQ*BZQZQQQ-VZQZQQQ/PZQZQQQ
+3000 QKQZQQQ=WKQZQQQ+ZKQZQQQ*KKQZQQQ-XKQZQQQ/JKQZQQQ
+3010 VKQZQQQ=PKQZQQQ+YKQZQQQ*QXQZQQQ-WXQZQQQ/ZXQZQQQ
+3020 XXQZQQQ=JXQZQQQ+BXQZQQQ*VXQZQQQ-PXQZQQQ/YXQZQQQ
+3030 WJQZQQQ=ZJQZQQQ+KJQZQQQ*XJQZQQQ-JJQZQQQ/BJQZQQQ
+3040 PJQZQQQ=YJQZQQQ+QBQZQQQ*WBQZQQQ-ZBQZQQQ/KBQZQQQ
+3050 JBQZQQQ=BBQZQQQ+VBQZQQQ*PBQZQQQ-YBQZQQQ/QVQZQQQ
+3060 ZVQZQQQ=KVQZQQQ+XVQZQQQ*JVQZQQQ-BVQZQQQ/VVQZQQQ
+3070 YVQZQQQ=QPQZQQQ+WPQZQQQ*ZPQZQQQ-KPQZQQQ/XPQZQQQ
+3080 BPQZQQQ=VPQZQQQ+PPQZQQQ*YPQZQQQ-QYQZQQQ/WYQZQQQ
+3090 KYQZQQQ=XYQZQQQ+JYQZQQQ*BYQZQQQ-VYQZQQQ/PYQZQQQ
+3100 QQWZQQQ=WQWZQQQ+ZQWZQQQ*KQWZQQQ-XQWZQQQ/JQWZQQQ
+3110 VQWZQQQ=PQWZQQQ+YQWZQQQ*QWWZQQQ-WWWZQQQ/ZWWZQQQ
+3120 XWWZQQQ=JWWZQQQ+BWWZQQQ*VWWZQQQ-PWWZQQQ/YWWZQQQ
+3130 WZWZQQQ=ZZWZQQQ+KZWZQQQ*XZWZQQQ-JZWZQQQ/BZWZQQQ
+3140 PZWZQQQ=YZWZQQQ+QKWZQQQ*WKWZQQQ-ZKWZQQQ/KKWZQQQ
+3150 JKWZQQQ=BKWZQQQ+VKWZQQQ*PKWZQQQ-YKWZQQQ/QXWZQQQ
+3160 ZXWZQQQ=KXWZQQQ+XXWZQQQ*JXWZQQQ-BXWZQQQ/VXWZQQQ
+3170 YXWZQQQ=QJWZQQQ+WJWZQQQ*ZJWZQQQ-KJWZQQQ/XJWZQQQ
+3180 BJWZQQQ=VJWZQQQ+PJWZQQQ*YJWZQQQ-QBWZQQQ/WBWZQQQ
+3190 KBWZQQQ=XBWZQQQ+JBWZQQQ*BBWZQQQ-VBWZQQQ/PBWZQQQ
+3200 QVWZQQQ=WVWZQQQ+ZVWZQQQ*KVWZQQQ-XVWZQQQ/JVWZQQQ
+3210 VVWZQQQ=PVWZQQQ+YVWZQQQ*QPWZQQQ-WPWZQQQ/ZPWZQQQ
+3220 XPWZQQQ=JPWZQQQ+BPWZQQQ*VPWZQQQ-PPWZQQQ/YPWZQQQ
+3230 WYWZQQQ=ZYWZQQQ+KYWZQQQ*XYWZQQQ-JYWZQQQ/BYWZQQQ
+3240 PYWZQQQ=YYWZQQQ+QQZZQQQ*WQZZQQQ-ZQZZQQQ/KQZZQQQ
+3250 JQZZQQQ=BQZZQQQ+VQZZQQQ*PQZZQQQ-YQZZQQQ/QWZZQQQ
+3260 ZWZZQQQ=KWZZQQQ+XWZZQQQ*JWZZQQQ-BWZZQQQ/VWZZQQQ
+3270 YWZZQQQ=QZZZQQQ+WZZZQQQ*ZZZZQQQ-KZZZQQQ/XZZZQQQ
+3280 BZZZQQQ=VZZZQQQ+PZZZQQQ*YZZZQQQ-QKZZQQQ/WKZZQQQ
+3290 KKZZQQQ=XKZZQQQ+JKZZQQQ*BKZZQQQ-VKZZQQQ/PKZZQQQ
+3300 QXZZQQQ=WXZZQQQ+ZXZZQQQ*KXZZQQQ-XXZZQQQ/JXZZQQQ
+3310 VXZZQQQ=PXZZQQQ+YXZZQQQ*QJZZQQQ-WJZZQQQ/ZJZZQQQ
+3320 XJZZQQQ=JJZZQQQ+BJZZQQQ*VJZZQQQ-PJZZQQQ/YJZZQQQ
+3330 WBZZQQQ=ZBZZQQQ+KBZZQQQ*XBZZQQQ-JBZZQQQ/BBZZQQQ
+3340 PBZZQQQ=YBZZQQQ+QVZZQQQ*WVZZQQQ-ZVZZQQQ/KVZZQQQ
+3350 JVZZQQQ=BVZZQQQ+VVZZQQQ*PVZZQQQ-YVZZQQQ/QPZZQQQ
+3360 ZPZZQQQ=KPZZQQQ+XPZZQQQ*JPZZQQQ-BPZZQQQ/VPZZQQQ
+3370 YPZZQQQ=QYZZQQQ+WYZZQQQ*ZYZZQQQ-KYZZQQQ/XYZZQQQ
+3380 BYZZQQQ=VYZZQQQ+PYZZQQQ*YYZZQQQ-QQKZQQQ/WQKZQQQ
+3390 KQKZQQQ=XQKZQQQ+JQKZQQQ*BQKZQQQ-VQKZQQQ/PQKZQQQ
+3400 QWKZQQQ=WWKZQQQ+ZWKZQQQ*KWKZQQQ-XWKZQQQ/JWKZQQQ
+3410 VWKZQQQ=PWKZQQQ+YWKZQQQ*QZKZQQQ-WZKZQQQ/ZZKZQQQ
+3420 XZKZQQQ=JZKZQQQ+BZKZQQQ*VZKZQQQ-PZKZQQQ/YZKZQQQ
+3430 WKKZQQQ=ZKKZQQQ+KKKZQQQ*XKKZQQQ-JKKZQQQ/BKKZQQQ
+3440 PKKZQQQ=YKKZQQQ+QXKZQQQ*WXKZQQQ-ZXKZQQQ/KXKZQQQ
+3450 JXKZQQQ=BXKZQQQ+VXKZQQQ*PXKZQQQ-YXKZQQQ/QJKZQQQ
+3460 ZJKZQQQ=KJKZQQQ+XJKZQQQ*JJKZQQQ-BJKZQQQ/VJKZQQQ
+3470 YJKZQQQ=QBKZQQQ+WBKZQQQ*ZBKZQQQ-KBKZQQQ/XBKZQQQ
+3480 BBKZQQQ=VBKZQQQ+PBKZQQQ*YBKZQQQ-QVKZQQQ/WVKZQQQ
+3490 KVKZQQQ=XVKZQQQ+JVKZQQQ*BVKZQQQ-VVKZQQQ/PVKZQQQ
+3500 QPKZQQQ=WPKZQQQ+ZPKZQQQ*KPKZQQQ-XPKZQQQ/JPKZQQQ
+3510 VPKZQQQ=PPKZQQQ+YPKZQQQ*QYKZQQQ-WYKZQQQ/ZYKZQQQ
+3520 XYKZQQQ=JYKZQQQ+BYKZQQQ*VYKZQQQ-PYKZQQQ/YYKZQQQ
+3530 WQXZQQQ=ZQXZQQQ+KQXZQQQ*XQXZQQQ-JQXZQQQ/BQXZQQQ
+3540 PQXZQQQ=YQXZQQQ+QWXZQQQ*WWXZQQQ-ZWXZQQQ/KWXZQQQ
+3550 JWXZQQQ=BWXZQQQ+VWXZQQQ*PWXZQQQ-YWXZQQQ/QZXZQQQ
+3560 ZZXZQQQ=KZXZQQQ+XZXZQQQ*JZXZQQQ-BZXZQQQ/VZXZQQQ
+3570 YZXZQQQ=QKXZQQQ+WKXZQQQ*ZKXZQQQ-KKXZQQQ/XKXZQQQ
+3580 BKXZQQQ=VKXZQQQ+PKXZQQQ*YKXZQQQ-QXXZQQQ/WXXZQQQ
+3590 KXXZQQQ=XXXZQQQ+JXXZQQQ*BXXZQQQ-VXXZQQQ/PXXZQQQ
+3600 QJXZQQQ=WJXZQQQ+ZJXZQQQ*KJXZQQQ-XJXZQQQ/JJXZQQQ
+3610 VJXZQQQ=PJXZQQQ+YJXZQQQ*QBXZQQQ-WBXZQQQ/ZBXZQQQ
+3620 XBXZQQQ=JBXZQQQ+BBXZQQQ*VBXZQQQ-PBXZQQQ/YBXZQQQ
+3630 WVXZQQQ=ZVXZQQQ+KVXZQQQ*XVXZQQQ-JVXZQQQ/BVXZQQQ
+3640 PVXZQQQ=YVXZQQQ+QPXZQQQ*WPXZQQQ-ZPXZQQQ/KPXZQQQ
+3650 JPXZQQQ=BPXZQQQ+VPXZQQQ*PPXZQQQ-YPXZQQQ/QYXZQQQ
+3660 ZYXZQQQ=KYXZQQQ+XYXZQQQ*JYXZQQQ-BYXZQQQ/VYXZQQQ
+3670 YYXZQQQ=QQJZQQQ+WQJZQQQ*ZQJZQQQ-KQJZQQQ/XQJZQQQ
+3680 BQJZQQQ=VQJZQQQ+PQJZQQQ*YQJZQQQ-QWJZQQQ/WWJZQQQ
+3690 KWJZQQQ=XWJZQQQ+JWJZQQQ*BWJZQQQ-VWJZQQQ/PWJZQQQ
+3700 QZJZQQQ=WZJZQQQ+ZZJZQQQ*KZJZQQQ-XZJZQQQ/JZJZQQQ
+3710 VZJZQQQ=PZJZQQQ+YZJZQQQ*QKJZQQQ-WKJZQQQ/ZKJZQQQ
+3720 XKJZQQQ=JKJZQQQ+BKJZQQQ*VKJZQQQ-PKJZQQQ/YKJZQQQ
+3730 WXJZQQQ=ZXJZQQQ+KXJZQQQ*XXJZQQQ-JXJZQQQ/BXJZQQQ
+3740 PXJZQQQ=YXJZQQQ+QJJZQQQ*WJJZQQQ-ZJJZQQQ/KJJZQQQ
+3750 JJJZQQQ=BJJZQQQ+VJJZQQQ*PJJZQQQ-YJJZQQQ/QBJZQQQ
+3760 ZBJZQQQ=KBJZQQQ+XBJZQQQ*JBJZQQQ-BBJZQQQ/VBJZQQQ
+3770 YBJZQQQ=QVJZQQQ+WVJZQQQ*ZVJZQQQ-KVJZQQQ/XVJZQQQ
+3780 BVJZQQQ=VVJZQQQ+PVJZQQQ*YVJZQQQ-QPJZQQQ/WPJZQQQ
+3790 KPJZQQQ=XPJZQQQ+JPJZQQQ*BPJZQQQ-VPJZQQQ/PPJZQQQ
+3800 QYJZQQQ=WYJZQQQ+ZYJZQQQ*KYJZQQQ-XYJZQQQ/JYJZQQQ
+3810 VYJZQQQ=PYJZQQQ+YYJZQQQ*QQBZQQQ-WQBZQQQ/ZQBZQQQ
+3820 XQBZQQQ=JQBZQQQ+BQBZQQQ*VQBZQQQ-PQBZQQQ/YQBZQQQ
+3830 WWBZQQQ=ZWBZQQQ+KWBZQQQ*XWBZQQQ-JWBZQQQ/BWBZQQQ
+3840 PWBZQQQ=YWBZQQQ+QZBZQQQ*WZBZQQQ-ZZBZQQQ/KZBZQQQ
+3850 JZBZQQQ=BZBZQQQ+VZBZQQQ*PZBZQQQ-YZBZQQQ/QKBZQQQ
+3860 ZKBZQQQ=KKBZQQQ+XKBZQQQ*JKBZQQQ-BKBZQQQ/VKBZQQQ
+3870 YKBZQQQ=QXBZQQQ+WXBZQQQ*ZXBZQQQ-KXBZQQQ/XXBZQQQ
+3880 BXBZQQQ=VXBZQQQ+PXBZQQQ*YXBZQQQ-QJBZQQQ/WJBZQQQ
+3890 KJBZQQQ=XJBZQQQ+JJBZQQQ*BJBZQQQ-VJBZQQQ/PJBZQQQ
+3900 QBBZQQQ=WBBZQQQ+ZBBZQQQ*KBBZQQQ-XBBZQQQ/JBBZQQQ
+3910 VBBZQQQ=PBBZQQQ+YBBZQQQ*QVBZQQQ-WVBZQQQ/ZVBZQQQ
+3920 XVBZQQQ=JVBZQQQ+BVBZQQQ*VVBZQQQ-PVBZQQQ/YVBZQQQ
+3930 WPBZQQQ=ZPBZQQQ+KPBZQQQ*XPBZQQQ-JPBZQQQ/BPBZQQQ
+3940 PPBZQQQ=YPBZQQQ+QYBZQQQ*WYBZQQQ-ZYBZQQQ/KYBZQQQ
+3950 JYBZQQQ=BYBZQQQ+VYBZQQQ*PYBZQQQ-YYBZQQQ/QQVZQQQ
+3960 ZQVZQQQ=KQVZQQQ+XQVZQQQ*JQVZQQQ-BQVZQQQ/VQVZQQQ
+3970 YQVZQQQ=QWVZQQQ+WWVZQQQ*ZWVZQQQ-KWVZQQQ/XWVZQQQ
+3980 BWVZQQQ=VWVZQQQ+PWVZQQQ*YWVZQQQ-QZVZQQQ/WZVZQQQ
+3990 KZVZQQQ=XZVZQQQ+JZVZQQQ*BZVZQQQ-VZVZQQQ/PZVZQQQ
+4000 QKVZQQQ=WKVZQQQ+ZKVZQQQ*KKVZQQQ-XKVZQQQ/JKVZQQQ
+4010 VKVZQQQ=PKVZQQQ+YKVZQQQ*QXVZQQQ-WXVZQQQ/ZXVZQQQ
+4020 XXVZQQQ=JXVZQQQ+BXVZQQQ*VXVZQQQ-PXVZQQQ/YXVZQQQ
+4030 WJVZQQQ=ZJVZQQQ+KJVZQQQ*XJVZQQQ-JJVZQQQ/BJVZQQQ
+4040 PJVZQQQ=YJVZQQQ+QBVZQQQ*WBVZQQQ-ZBVZQQQ/KBVZQQQ
+4050 JBVZQQQ=BBVZQQQ+VBVZQQQ*PBVZQQQ-YBVZQQQ/QVVZQQQ
+4060 ZVVZQQQ=KVVZQQQ+XVVZQQQ*JVVZQQQ-BVVZQQQ/VVVZQQQ
+4070 YVVZQQQ=QPVZQQQ+WPVZQQQ*ZPVZQQQ-KPVZQQQ/XPVZQQQ
+4080 BPVZQQQ=VPVZQQQ+PPVZQQQ*YPVZQQQ-QYVZQQQ/WYVZQQQ
+4090 KYVZQQQ=XYVZQQQ+JYVZQQQ*BYVZQQQ-VYVZQQQ/PYVZQQQ
+9000 PRINT "LOADED"
+9010 END
@@ -30,6 +30,27 @@ COMMAND.C - This is where most of the command line is processed.
 
 
 #include "bas51.h"
+#include "ext_tokens.h"
+#include "stats.h"
+#include "cost51.h"
+
+#ifndef __C51__
+#include <stdlib.h>     // qsort() and malloc() for the profiler
+#endif
+
+void BumpVarGeneration(void);   // vars.c
+BIT ResolveLineConst(WORD ConstAddr);   // flow_cmds.c
+BIT DoSnapshotCmd(void);                // io_cmds.c
+void StartProfile(BIT Enable);
+BIT DoProfileCmd(void);
+BIT DoStatsCmd(void);
+BIT DoElseCmd(void);                    // flow_cmds.c
+BIT DoWhileCmd(void);                   // flow_cmds.c
+BIT DoWendCmd(void);                    // flow_cmds.c
+BIT DoDoCmd(void);                      // flow_cmds.c
+BIT DoLoopCmd(void);                    // flow_cmds.c
+BIT DoSelectCmd(void);                  // flow_cmds.c
+BIT DoCaseCmd(void);                    // flow_cmds.c
 
 //XDATA WORD *Bytes = (BYTE *) TokBuf;         // Array of 16 BYTEs
 //XDATA WORD *Word = (WORD *) (TokBuf + 16);  // Array of WORDs
@@ -44,7 +65,10 @@ BIT TerminalChar(void)
     if (CurChar == '\r' || CurChar == TOKEN_COLON) return(TRUE);
     if (CurChar == TOKEN_ELSE)
     {
-        SetStream51((WORD)(GetStreamAddr() + ReadStream51()));
+        WORD Addr;
+
+        Addr = ReadStream51();    // offset is from the byte after it
+        SetStream51((WORD)(Addr + GetStreamAddr()));
         return(TRUE);
     }
     return(FALSE);
@@ -317,7 +341,12 @@ Error:
 
 BIT DoRunCmd(void)
 {
+    BIT Profile;
+
     CurChar = GetNextToken();
+    Profile = (BIT)(CurChar == TOKEN_PROFILE);
+    if (Profile) CurChar = GetNextToken();   // RUN PROFILE [line]
+
     if (TerminalChar()) wArg[0] = BasicVars.ProgStart;
     else if (ForceLineNumber(CurChar))
     {
@@ -337,6 +366,7 @@ Error:
     // wArg[0] has line address if here
     SetStream51(wArg[0]);
     ClearVariables();
+    StartProfile(Profile);
 	Running=TRUE;
 
     return(FALSE);
@@ -344,6 +374,12 @@ Error:
 
 BIT DoEndCmd(void)
 {
+    if (PeekStream51() == TOKEN_SELECT)     // END SELECT, nothing to do
+    {
+        ReadStream51();
+        return((BIT) !GetTerminalToken());
+    }
+
     if (!GetTerminalToken()) return(TRUE);  // no parameters allowed here
     SetStream51(0xFFFF);
 	Running=FALSE;
@@ -441,6 +477,7 @@ BIT DoDefTypesCmd(void)
             {
                 DefTypes[Letter[0]++] = DefType;
             }
+            BumpVarGeneration();   // cached references may change type
 
             // exit if terminal char
             if (TerminalChar()) break;
@@ -625,6 +662,43 @@ void ExecuteCommand(void)
             if (DoIfCmd()) goto Error;
             break;
 
+        // IF <expression> BEGIN ... [ELSE ...] ENDIF
+        case TOKEN_ELSE:
+            if (DoElseCmd()) goto Error;
+            break;
+
+        case TOKEN_ENDIF:
+            if (!GetTerminalToken()) goto Error;
+            break;
+
+        // WHILE <expression> ... WEND
+        case TOKEN_WHILE:
+            if (DoWhileCmd()) goto Error;
+            break;
+
+        case TOKEN_WEND:
+            if (DoWendCmd()) goto Error;
+            break;
+
+        // DO ... LOOP [WHILE <expression> | UNTIL <expression>]
+        case TOKEN_DO:
+            if (DoDoCmd()) goto Error;
+            break;
+
+        case TOKEN_LOOP:
+            if (DoLoopCmd()) goto Error;
+            break;
+
+        // SELECT CASE <expression>
+        // CASE <expression> [, <expression> ...] ... [CASE ELSE ...] END SELECT
+        case TOKEN_SELECT:
+            if (DoSelectCmd()) goto Error;
+            break;
+
+        case TOKEN_CASE:
+            if (DoCaseCmd()) goto Error;
+            break;
+
 
         // RENUM [OldNum] [,[NewNum] [,Increment]
         case TOKEN_RENUM:
@@ -687,6 +761,18 @@ void ExecuteCommand(void)
             if (DoSaveFileCmd()) goto Error;
             break;
 
+        case TOKEN_SNAPSHOT:
+            if (DoSnapshotCmd()) goto Error;
+            break;
+
+        case TOKEN_PROFILE:
+            if (DoProfileCmd()) goto Error;
+            break;
+
+        case TOKEN_STATS:
+            if (DoStatsCmd()) goto Error;
+            break;
+
         case TOKEN_ON:
             if (DoOnCmd()) goto Error;
             break;
@@ -728,6 +814,708 @@ Error:
 }
 
 
+// STATEMENT VM
+// An optional execution engine for hosts, built with -DBAS51_VM.  Each
+// statement in the program is decoded into a table entry the second time
+// it runs, after the token interpreter has run it once and compiled its
+// expressions.  The entry holds an opcode and what the statement needs:
+// the resolved target and return position for GOTO and GOSUB, the typed
+// code of the expressions in LET, IF and FOR, the address of the value of
+// the FOR variable, the hash NEXT looks for and where the statement ends.
+// LET, IF, FOR and NEXT run from the entry without reading the statement
+// or looking up a variable again.  Variable addresses are only good for
+// one VarGeneration, so an entry is decoded again when it changes.
+// Everything else, and every statement that can't be decoded, goes to
+// ExecuteCommand().  Every statement still finishes in ExecuteLine(), so
+// errors, ON ERROR and BREAK work exactly as in the token interpreter,
+// which remains the reference.
+
+#ifdef BAS51_VM
+
+#ifdef __C51__
+#error BAS51_VM is for the Win32 and POSIX versions
+#endif
+
+#ifndef VM_TABLE_SIZE
+#define VM_TABLE_SIZE  1024    // must be a power of 2
+#endif
+
+enum { VM_EXEC, VM_REM, VM_GOTO, VM_GOSUB, VM_LET, VM_IF, VM_FOR, VM_NEXT };
+
+// VmJumps bits for IF
+#define VM_JUMP_FALSE  1       // line number after ELSE or the end of the IF
+#define VM_JUMP_TRUE   2       // GOTO, or a line number after THEN
+
+XDATA WORD VmAddr[VM_TABLE_SIZE];    // Address of statement, 0 = empty
+XDATA WORD VmGen[VM_TABLE_SIZE];     // VarGeneration when decoded
+XDATA BYTE VmOp[VM_TABLE_SIZE];      // VM_xxx
+XDATA BYTE VmTerm[VM_TABLE_SIZE];    // Token that ends the statement
+XDATA WORD VmNext[VM_TABLE_SIZE];    // Stream address after the statement
+XDATA WORD VmTarget[VM_TABLE_SIZE];  // Jump address, IF false address
+XDATA WORD VmLine[VM_TABLE_SIZE];    // Jump line number
+XDATA WORD VmCode[VM_TABLE_SIZE];    // Typed code: LET, IF test, FOR start
+XDATA WORD VmTo[VM_TABLE_SIZE];      // Typed code: FOR limit
+XDATA WORD VmStep[VM_TABLE_SIZE];    // Typed code: FOR step, 0 = none
+XDATA WORD VmVar[VM_TABLE_SIZE];     // FOR variable address
+XDATA DWORD VmHash[VM_TABLE_SIZE];   // FOR and NEXT variable hash
+XDATA BYTE VmJumps[VM_TABLE_SIZE];   // VM_JUMP_xxx
+
+void ClearTypedCode(void);                      // expression.c
+BIT TypedCodeFull(void);                        // expression.c
+BIT RunTypedCode(WORD Code);                    // expression.c
+WORD TypeExprCode(WORD Addr, BYTE Flags, BYTE Type, BYTE *Stop,
+                  WORD *End);                   // expression.c
+BIT PushForLoop(void);                          // flow_cmds.c
+BIT NextLoop(DWORD Hash);                       // flow_cmds.c
+extern WORD VarGeneration;                      // vars.c
+
+#endif
+
+
+// Forget every decoded statement.
+// Called whenever the program changes.
+
+void ClearVMCache(void)
+{
+#ifdef BAS51_VM
+    WORD i;
+
+    for (i = 0; i != VM_TABLE_SIZE; i++) VmAddr[i] = 0;
+    ClearTypedCode();
+#endif
+}
+
+
+#ifdef BAS51_VM
+
+// Decode [LET] var = expression
+
+static void DecodeLet(WORD Addr, WORD Slot)
+{
+    BYTE Stop;
+    WORD End;
+
+    VmCode[Slot] = TypeExprCode(Addr, EXPRESSION_ASSIGNMENT_FLAG, 0, &Stop, &End);
+    if (!VmCode[Slot]) return;
+    if (Stop != '\r' && Stop != TOKEN_COLON && Stop != TOKEN_ELSE) return;
+
+    VmOp[Slot] = VM_LET;
+    VmTerm[Slot] = Stop;
+    VmNext[Slot] = End;
+}
+
+
+// Decode IF <offset> expression THEN|GOTO ...
+// Block IFs are left to DoIfCmd().
+
+static void DecodeIf(WORD Addr, WORD Slot)
+{
+    BYTE Stop;
+    WORD End, False;
+
+    False = (WORD)(ReadRandom51(Addr) + Addr + 1);
+    VmCode[Slot] = TypeExprCode((WORD)(Addr + 1), FALSE, 0, &Stop, &End);
+    if (!VmCode[Slot]) return;
+    if (Stop != TOKEN_THEN && Stop != TOKEN_GOTO) return;
+
+    VmJumps[Slot] = 0;
+    if (ReadRandom51(False) == TOKEN_INTL_CONST)
+        VmJumps[Slot] |= VM_JUMP_FALSE;
+    if (Stop == TOKEN_GOTO || ReadRandom51(End) == TOKEN_INTL_CONST)
+        VmJumps[Slot] |= VM_JUMP_TRUE;
+
+    VmOp[Slot] = VM_IF;
+    VmTerm[Slot] = Stop;
+    VmNext[Slot] = End;
+    VmTarget[Slot] = False;
+}
+
+
+// Decode FOR var = expression TO expression [STEP expression]
+
+static void DecodeFor(WORD Addr, WORD Slot)
+{
+    BYTE Token, Type;
+    WORD End;
+
+    Token = ReadRandom51(Addr);
+    if (Token < TOKEN_NOTYPE_VAR || Token > TOKEN_FLOAT_VAR) return;
+
+    SetStream51((WORD)(Addr + 1));
+    VmVar[Slot] = GetProgVarPtr(VARPTR_ASSIGN_SIMPLE);
+    if (!VmVar[Slot])
+    {
+        SyntaxErrorCode = ERROR_NONE;  // let ExecuteCommand() report it
+        return;
+    }
+    if (uHash.str.TypeFlag == 0)     // untyped, use default
+        uHash.str.TypeFlag = DefTypes[uHash.str.First];
+    Type = (BYTE)(TOKEN_NOTYPE_VAR + uHash.str.TypeFlag - 4);
+    if (Type != TOKEN_INTL_CONST && Type != TOKEN_FLOAT_CONST) return;
+    VmHash[Slot] = uHash.d;
+
+    if (ReadStream51() != TOKEN_EQUALS) return;
+    VmCode[Slot] = TypeExprCode(GetStreamAddr(), FALSE, Type, &Token, &End);
+    if (!VmCode[Slot] || Token != TOKEN_TO) return;
+
+    VmTo[Slot] = TypeExprCode(End, FALSE, Type, &Token, &End);
+    if (!VmTo[Slot]) return;
+
+    VmStep[Slot] = 0;
+    if (Token == TOKEN_STEP)
+    {
+        VmStep[Slot] = TypeExprCode(End, FALSE, Type, &Token, &End);
+        if (!VmStep[Slot]) return;
+    }
+    if (Token != '\r' && Token != TOKEN_COLON) return;
+
+    VmOp[Slot] = VM_FOR;
+    VmTerm[Slot] = Token;
+    VmNext[Slot] = End;
+}
+
+
+// Decode NEXT [var]
+
+static void DecodeNext(WORD Addr, WORD Slot)
+{
+    BYTE Token;
+
+    Token = ReadRandom51(Addr);
+    VmHash[Slot] = 0;
+    if (Token >= TOKEN_NOTYPE_VAR && Token <= TOKEN_FLOAT_VAR)
+    {
+        SetStream51((WORD)(Addr + 1));
+        ReadProgVarHash();
+        if (uHash.str.TypeFlag == 3) return;  // strings not allowed
+        VmHash[Slot] = uHash.d;
+        Addr = GetStreamAddr();
+        Token = ReadRandom51(Addr);
+    }
+    if (Token != '\r' && Token != TOKEN_COLON) return;
+
+    VmOp[Slot] = VM_NEXT;
+    VmTerm[Slot] = Token;
+    VmNext[Slot] = (WORD)(Addr + 1);
+}
+
+
+// Decode the statement at Addr into table entry Slot.
+
+void DecodeStatement(WORD Addr, WORD Slot)
+{
+    BYTE Token;
+    WORD ptr;
+
+    VmOp[Slot] = VM_EXEC;
+
+    Token = ReadRandom51(Addr);
+    ptr = (WORD)(Addr + 1);
+
+    if (Token == TOKEN_REM || Token == TOKEN_REM2)
+    {
+        while (ReadRandom51(ptr++) != '\r');
+        VmOp[Slot] = VM_REM;
+        VmNext[Slot] = ptr;
+    }
+    else if ((Token == TOKEN_GOTO || Token == TOKEN_GOSUB) &&
+             ReadRandom51(ptr) == TOKEN_INTL_CONST)
+    {
+        // Only a plain line number followed by the end of the statement
+        Token = ReadRandom51((WORD)(ptr + 5));
+        if (Token == '\r' || Token == TOKEN_COLON)
+        {
+            uData.LVal = ReadRandomLong((WORD)(ptr + 1));
+            if (ResolveLineConst(0))   // don't link, we remember it here
+                SyntaxErrorCode = ERROR_NONE;  // let ExecuteCommand() report it
+            else if (uData.wVal[0] != 3)       // there is such a line
+            {
+                VmOp[Slot] = (BYTE)(ReadRandom51(Addr) == TOKEN_GOTO ?
+                    VM_GOTO : VM_GOSUB);
+                VmTerm[Slot] = Token;
+                VmNext[Slot] = (WORD)(ptr + 6);
+                VmTarget[Slot] = uData.wVal[0];
+                VmLine[Slot] = uData.wVal[1];
+            }
+        }
+    }
+    else if (Token == TOKEN_LET) DecodeLet(ptr, Slot);
+    else if (Token == TOKEN_IF) DecodeIf(ptr, Slot);
+    else if (Token == TOKEN_FOR) DecodeFor(ptr, Slot);
+    else if (Token == TOKEN_NEXT) DecodeNext(ptr, Slot);
+
+    // Stamp it last, decoding LET and FOR may create the variable
+    VmGen[Slot] = VarGeneration;
+    SetStream51(Addr);    // back to the statement for ExecuteCommand()
+}
+
+
+// Run the statement the stream points to.
+
+void RunStatement(void)
+{
+    WORD Addr, Slot;
+
+    Addr = BasicVars.CurCmdAddr;
+    if (Addr < BasicVars.ProgStart || Addr >= BasicVars.VarStart)
+    {
+        ExecuteCommand();    // command line
+        return;
+    }
+
+    Slot = (WORD)((Addr ^ (Addr >> 7)) & (VM_TABLE_SIZE - 1));
+    if (VmAddr[Slot] == Addr && VmGen[Slot] != VarGeneration)
+    {
+        if (TypedCodeFull()) ClearVMCache();    // start over
+        else DecodeStatement(Addr, Slot);
+    }
+
+    if (VmAddr[Slot] != Addr)
+    {
+        // First time here.  Let the token interpreter compile it, decode
+        // it next time.  VarGeneration is never 0.
+        VmAddr[Slot] = Addr;
+        VmGen[Slot] = 0;
+        ExecuteCommand();
+        return;
+    }
+
+    switch (VmOp[Slot])
+    {
+        case VM_REM:
+            SetStream51(VmNext[Slot]);
+            CurChar = '\r';
+            break;
+
+        case VM_GOTO:
+        case VM_GOSUB:
+            SetStream51(VmNext[Slot]);
+            CurChar = VmTerm[Slot];
+            uData.wVal[0] = VmTarget[Slot];
+            uData.wVal[1] = VmLine[Slot];
+            GotoHelper((BIT)(VmOp[Slot] == VM_GOSUB));
+            break;
+
+        case VM_LET:
+            if (RunTypedCode(VmCode[Slot])) break;
+            SetStream51(VmNext[Slot]);
+            CurChar = VmTerm[Slot];
+            TerminalChar();    // skips ELSE
+            break;
+
+        case VM_IF:    // as DoIfCmd()
+            if (RunTypedCode(VmCode[Slot])) break;
+            if (uData.LVal == 0)   // Make FALSE jump to ELSE or end of line
+            {
+                SetStream51(VmTarget[Slot]);
+                CurChar = TOKEN_COLON;
+                if ((VmJumps[Slot] & VM_JUMP_FALSE) && DoGotoCmd(FALSE))
+                    goto Error;
+            }
+            else
+            {
+                SetStream51(VmNext[Slot]);
+                CurChar = VmTerm[Slot];
+                if (VmJumps[Slot] & VM_JUMP_TRUE)
+                {
+                    if (DoGotoCmd(FALSE)) goto Error;
+                }
+                else CurChar = TOKEN_COLON;
+            }
+            break;
+
+        case VM_FOR:    // as DoForCmd()
+            gFor.CtrlVarPtr = VmVar[Slot];
+            uHash.d = VmHash[Slot];
+            gFor.VarType = (BYTE)(TOKEN_NOTYPE_VAR + uHash.str.TypeFlag);
+            gFor.Hash = uHash;
+
+            if (RunTypedCode(VmCode[Slot])) break;
+            WriteVar(gFor.VarType, gFor.CtrlVarPtr);
+
+            if (RunTypedCode(VmTo[Slot])) break;
+            gFor.ToField = uData;
+
+            if (VmStep[Slot])
+            {
+                if (RunTypedCode(VmStep[Slot])) break;
+            }
+            else if (gFor.VarType == TOKEN_FLOAT_VAR) uData.fVal = 1.0;
+            else uData.LVal = 1;
+            gFor.StepField = uData;
+
+            SetStream51(VmNext[Slot]);
+            CurChar = VmTerm[Slot];
+            if (PushForLoop()) goto Error;
+            break;
+
+        case VM_NEXT:
+            SetStream51(VmNext[Slot]);
+            CurChar = VmTerm[Slot];
+            if (NextLoop(VmHash[Slot])) goto Error;
+            break;
+
+        default:
+            ExecuteCommand();
+            break;
+    }
+
+    return;
+
+Error:
+    if (SyntaxErrorCode == 0) SyntaxErrorCode = ERROR_SYNTAX;
+}
+
+#endif
+
+
+
+// PROFILER
+// RUN PROFILE clears the tables below and sets Profiling.  From then on
+// ExecuteLine() times every statement the program runs and charges it to the
+// line the statement started on and to its statement token.  That is self
+// time: a GOSUB is charged for the jump and the subroutine's lines for their
+// own work.  PROFILE prints the lines and tokens sorted by time, a short
+// list to the screen or all of it to a file.  The tables by line number are
+// only allocated by the first RUN PROFILE, so with Profiling clear the only
+// cost is one test per statement.  None of this is in the 8051 version,
+// which only skips the word PROFILE after RUN.  In a BAS51_COST build the
+// estimated 8051 cycles are kept the same way and shown as target time.
+
+#ifndef __C51__
+
+#define PROF_SCREEN_ROWS  6    // rows of each list that fit on the screen
+
+#ifdef BAS51_COST
+#define PROF_TABLES       3    // tables by line number
+#else
+#define PROF_TABLES       2
+#endif
+
+BIT Profiling;
+DWORD *ProfCount;           // statements run, by line number
+DWORD *ProfTime;            // microseconds, by line number
+DWORD ProfTokCount[256];    // statements run, by statement token
+DWORD ProfTokTime[256];     // microseconds, by statement token
+#ifdef BAS51_COST
+DWORD *ProfCycles;          // 8051 cycles, by line number
+DWORD ProfTokCycles[256];   // 8051 cycles, by statement token
+DWORD ProfStartCycles;
+#endif
+
+DWORD GetProfileCount(void);                // drivers.c
+BYTE *GetTokenFromTable(BYTE Token);        // tokenizer.c
+void DetokPutc(BYTE c);                     // tokenizer.c
+void DetokPrint(char *s);                   // tokenizer.c
+void FlushDetok(void);                      // tokenizer.c
+extern BIT DetokToFile;                     // tokenizer.c
+extern WORD DetokLen;                       // tokenizer.c
+extern BIT DetokError;                      // tokenizer.c
+
+
+// Called at the top of ExecuteLine().  Returns the statement token and the
+// start time in *Start.
+
+BYTE ProfileBegin(DWORD *Start)
+{
+    BYTE Token;
+
+    // Anything that is not a statement keyword is an assignment
+    Token = ReadRandom51(BasicVars.CurCmdAddr);
+    if (Token < COMMAND_TOKEN_START &&
+        (Token < EXT_TOKEN_START || Token >= LAST_EXT_TOKEN))
+        Token = TOKEN_LET;
+
+#ifdef BAS51_COST
+    ProfStartCycles = Cycles51;
+#endif
+    *Start = GetProfileCount();
+    return(Token);
+}
+
+
+void ProfileEnd(WORD Line, BYTE Token, DWORD Start)
+{
+    DWORD Time;
+
+    Time = GetProfileCount() - Start;
+    ProfCount[Line]++;
+    ProfTime[Line] += Time;
+    ProfTokCount[Token]++;
+    ProfTokTime[Token] += Time;
+#ifdef BAS51_COST
+    Time = Cycles51 - ProfStartCycles;
+    ProfCycles[Line] += Time;
+    ProfTokCycles[Token] += Time;
+#endif
+}
+
+
+static int CompareProfLines(const void *a, const void *b)
+{
+    WORD A = *(WORD *) a, B = *(WORD *) b;
+
+    if (ProfTime[A] != ProfTime[B]) return(ProfTime[A] < ProfTime[B] ? 1 : -1);
+    return(A < B ? -1 : 1);
+}
+
+
+static int CompareProfTokens(const void *a, const void *b)
+{
+    BYTE A = *(BYTE *) a, B = *(BYTE *) b;
+
+    if (ProfTokTime[A] != ProfTokTime[B])
+        return(ProfTokTime[A] < ProfTokTime[B] ? 1 : -1);
+    return(A < B ? -1 : 1);
+}
+
+
+static void ProfNewLine(void)
+{
+    if (DetokToFile) DetokPrint("\r\n");   // files keep DOS line endings
+    else VGA_putchar('\n');
+}
+
+
+static void ProfHeader(char *Name)
+{
+    char Row[64];
+
+    sprintf(Row, "%-8s %10s %12s %6s", Name, "COUNT", "MICROSECS", "TIME");
+#ifdef BAS51_COST
+    strcat(Row, "  TARGET MS");
+#endif
+    DetokPrint(Row);
+    ProfNewLine();
+}
+
+
+#ifdef BAS51_COST
+#define PROF_CYCLES(Table, i)  (Table[i])
+#else
+#define PROF_CYCLES(Table, i)  0
+#endif
+
+static void ProfRow(char *Name, DWORD Count, DWORD Time, DWORD Total,
+                    double Cycles)
+{
+    char Row[64];
+
+    sprintf(Row, "%-8s %10lu %12lu %5.1f%%", Name,
+            (unsigned long) Count, (unsigned long) Time,
+            Total ? Time * 100.0 / Total : 0.0);
+#ifdef BAS51_COST
+    sprintf(Row + strlen(Row), " %10.1f", Cycles / CYCLES51_PER_MS);
+#endif
+    DetokPrint(Row);
+    ProfNewLine();
+}
+
+
+// Print the profile to the screen, or to the open file if ToFile.
+
+void PrintProfile(BIT ToFile)
+{
+    WORD *Lines;
+    BYTE Tokens[256];
+    DWORD Total, Count, n, i, Rows;
+    double Cycles;
+    char Name[12];
+    BYTE *bp;
+
+    Total = Count = n = 0;
+    Cycles = 0;
+    Lines = NULL;
+    if (ProfCount)    // there has been a RUN PROFILE
+    {
+        Lines = (WORD *) malloc(65536L * sizeof(WORD));
+        if (Lines == NULL)
+        {
+            SyntaxErrorCode = ERROR_INSUFFICIENT_MEMORY;
+            return;
+        }
+
+        for (i = 0; i != 65536L; i++)
+        {
+            if (ProfCount[i]) Lines[n++] = (WORD) i;
+            Total += ProfTime[i];
+            Count += ProfCount[i];
+            Cycles += PROF_CYCLES(ProfCycles, i);
+        }
+        qsort(Lines, n, sizeof(WORD), CompareProfLines);
+    }
+
+    DetokToFile = ToFile;
+    DetokLen = 0;
+    DetokError = FALSE;
+
+    Rows = ToFile ? n : min(n, PROF_SCREEN_ROWS);
+    ProfHeader("LINE");
+    for (i = 0; i != Rows; i++)
+    {
+        sprintf(Name, "%u", Lines[i]);
+        ProfRow(Name, ProfCount[Lines[i]], ProfTime[Lines[i]], Total,
+                PROF_CYCLES(ProfCycles, Lines[i]));
+    }
+    ProfRow("TOTAL", Count, Total, Total, Cycles);
+    free(Lines);
+
+    n = 0;
+    for (i = 0; i != 256; i++) if (ProfTokCount[i]) Tokens[n++] = (BYTE) i;
+    qsort(Tokens, n, sizeof(BYTE), CompareProfTokens);
+
+    Rows = ToFile ? n : min(n, PROF_SCREEN_ROWS);
+    ProfHeader("TOKEN");
+    for (i = 0; i != Rows; i++)
+    {
+        // copy the token's name out of its table
+        bp = GetTokenFromTable(Tokens[i]);
+        Name[0] = (char)(*bp++ & 0x7F);
+        for (n = 1; !(*bp & 0x80) && n != sizeof(Name) - 1; n++) Name[n] = *bp++;
+        Name[n] = 0;
+        ProfRow(Name, ProfTokCount[Tokens[i]], ProfTokTime[Tokens[i]], Total,
+                PROF_CYCLES(ProfTokCycles, Tokens[i]));
+    }
+
+    if (ToFile) FlushDetok();
+    DetokToFile = FALSE;
+}
+
+#endif
+
+
+// Clear the profile and turn it on, or just turn it off.  If there is no
+// memory for the tables the program just runs without a profile.
+
+void StartProfile(BIT Enable)
+{
+#ifndef __C51__
+    Profiling = FALSE;
+    if (!Enable) return;
+
+    if (ProfCount == NULL)    // the first RUN PROFILE
+    {
+        ProfCount = (DWORD *) malloc(PROF_TABLES * 65536L * sizeof(DWORD));
+        if (ProfCount == NULL) return;
+        ProfTime = ProfCount + 65536L;
+#ifdef BAS51_COST
+        ProfCycles = ProfTime + 65536L;
+#endif
+    }
+
+    Profiling = TRUE;
+    memset(ProfCount, 0, PROF_TABLES * 65536L * sizeof(DWORD));
+    memset(ProfTokCount, 0, sizeof(ProfTokCount));
+    memset(ProfTokTime, 0, sizeof(ProfTokTime));
+#ifdef BAS51_COST
+    memset(ProfTokCycles, 0, sizeof(ProfTokCycles));
+#endif
+#endif
+}
+
+
+// PROFILE [<Str-Const>]
+// Lists the last RUN PROFILE on the screen, or all of it in the file.
+
+BIT DoProfileCmd(void)
+{
+#ifdef __C51__
+    SyntaxErrorCode = ERROR_SYNTAX;    // host versions only
+    return(TRUE);
+#else
+    BIT ToFile;
+
+    CurChar = PeekStream51();
+    ToFile = (BIT)(CurChar != '\r' && CurChar != TOKEN_COLON &&
+                   CurChar != TOKEN_ELSE);
+    if (!ToFile)
+    {
+        if (!GetTerminalToken()) return(TRUE);
+    }
+    else
+    {
+        if (GetSimpleExpr() != TOKEN_STRING_CONST)
+        {
+            if (SyntaxErrorCode == ERROR_NONE) SyntaxErrorCode = ERROR_TYPE_CONFLICT;
+            return(TRUE);
+        }
+        if (!TerminalChar())
+        {
+            SyntaxErrorCode = ERROR_SYNTAX;
+            return(TRUE);
+        }
+        if (BasFileOpen(FALSE))
+        {
+            SyntaxErrorCode = ERROR_FILE_IO;
+            return(TRUE);
+        }
+    }
+
+    SyntaxErrorCode = ERROR_NONE;
+    PrintProfile(ToFile);
+    if (ToFile) BasFileClose();
+    if (DetokError) SyntaxErrorCode = ERROR_FILE_IO;
+
+    return((BIT)(SyntaxErrorCode != ERROR_NONE));
+#endif
+}
+
+
+#ifndef __C51__
+
+CODE char *StatNames[STAT_COUNT] =    // in stats.h order
+{
+    "STATEMENTS", "FINDLINE", "LINES SCANNED", "VAR LOOKUPS",
+    "VAR PROBES", "STREAM HITS", "STREAM REFILLS", "BYTES MOVED",
+    "STR ALLOCS", "STR FREES", "STR REALLOCS", "FREE LIST HITS",
+    "CALC STK MAX", "OPER STK MAX", "ARG STK MAX", "PARM STK MAX"
+};
+
+#endif
+
+
+// STATS [RESET]
+// Prints the counters in stats.h two to a line, or clears them.
+
+BIT DoStatsCmd(void)
+{
+#ifdef __C51__
+    SyntaxErrorCode = ERROR_SYNTAX;    // host versions only
+    return(TRUE);
+#else
+    char Name[5];
+    BYTE i;
+
+    CurChar = GetNextToken();
+    if (!TerminalChar())
+    {
+        // RESET is not a keyword, so it comes in as a variable name
+        if (CurChar != TOKEN_NOTYPE_VAR || uData.sVal.sLen != sizeof(Name))
+            goto Error;
+        ReadBlock51((BYTE *) Name, uData.sVal.sPtr, sizeof(Name));
+        if (memcmp(Name, "RESET", sizeof(Name)) != 0) goto Error;
+        if (!GetTerminalToken()) goto Error;
+
+        memset(Stats, 0, sizeof(Stats));
+        return(FALSE);
+    }
+
+    for (i = 0; i != STAT_COUNT; i++)
+    {
+        VGA_printf("%-14s%10lu", StatNames[i], (unsigned long) Stats[i]);
+        VGA_print((i & 1) || i == STAT_COUNT - 1 ? "\n" : "  ");
+    }
+
+    return(FALSE);
+
+Error:
+    SyntaxErrorCode = ERROR_SYNTAX;
+    return(TRUE);
+#endif
+}
+
+
+
 // Execute the line in memory pointed to by LinePtr
 // Return LinePtr to next line to be executed.
 // If LinePtr == 0xFFFF, then execute single line from InBuf[]
@@ -736,6 +1524,13 @@ Error:
 
 void ExecuteLine(void)
 {
+#ifndef __C51__
+    BIT Timed;
+    WORD ProfLine;
+    BYTE ProfToken;
+    DWORD ProfStart;
+#endif
+
     //SetStream51(ExecLinePtr);
 
     if (CurChar == '\r')
@@ -749,8 +1544,25 @@ void ExecuteLine(void)
 
 
     FreeTempAlloc();  // clear the temporary
+    COST51(COST51_STATEMENT);
+    STAT_INC(STAT_STATEMENTS);
     BasicVars.CurCmdAddr = GetStreamAddr();
+#ifndef __C51__
+    Timed = (BIT)(Profiling && LineNo != 0xFFFF);   // not immediate lines
+    if (Timed)
+    {
+        ProfLine = LineNo;
+        ProfToken = ProfileBegin(&ProfStart);
+    }
+#endif
+#ifdef BAS51_VM
+    RunStatement();
+#else
     ExecuteCommand();
+#endif
+#ifndef __C51__
+    if (Timed) ProfileEnd(ProfLine, ProfToken, ProfStart);
+#endif
 
     if (SyntaxErrorCode != ERROR_NONE)
     {
@@ -0,0 +1,102 @@
+/*
+This source file is part of the TRS-8051 project.  BAS51 is a work alike
+rewrite of the Microsoft Level 2 BASIC for the TRS-80 that is intended to run
+on an 8051 microprocessor.  This version is in intended to also run under
+Windows for testing purposes.
+
+Copyright (C) 2017  Dennis Hawkins
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+If you use this code in any way, I would love to hear from you.  My email
+address is: dennis@galliform.com
+*/
+
+/*
+COST51.H - Cycle cost model for the 8051 target.  A Win32 or POSIX build
+with BAS51_COST defined adds up in Cycles51 the machine cycles the target
+would spend as a program runs: every SPI RAM transfer and byte, every
+operator and function by type and every statement.  RUN PROFILE and PROFILE
+then show the projected target time of each line and of the whole program.
+
+The figures are estimates for a single cycle 8051 running Keil's float
+library with the RAM on a hardware SPI port.  Each can be overridden with
+-D to tune the model against the real board.
+*/
+
+#ifndef COST51_H
+#define COST51_H
+
+#ifdef BAS51_COST
+
+#ifdef __C51__
+#error BAS51_COST is for the Win32 and POSIX versions
+#endif
+#ifdef FLAT_MEMORY
+#error BAS51_COST counts the SPI RAM transfers, leave FLAT_MEMORY off
+#endif
+
+#ifndef CYCLES51_PER_MS
+#define CYCLES51_PER_MS     22118   // 22.1184 MHz
+#endif
+
+#ifndef COST51_SPI_SETUP
+#define COST51_SPI_SETUP    80      // chip select, command and address
+#endif
+#ifndef COST51_SPI_BYTE
+#define COST51_SPI_BYTE     20      // one byte through the SPI port
+#endif
+#ifndef COST51_STATEMENT
+#define COST51_STATEMENT    150     // ExecuteLine() and the command switch
+#endif
+#ifndef COST51_INT_OP
+#define COST51_INT_OP       30      // 32 bit add, compare or logic
+#endif
+#ifndef COST51_INT_MUL
+#define COST51_INT_MUL      120
+#endif
+#ifndef COST51_INT_DIV
+#define COST51_INT_DIV      900
+#endif
+#ifndef COST51_FLOAT_OP
+#define COST51_FLOAT_OP     200     // add, subtract or compare
+#endif
+#ifndef COST51_FLOAT_MUL
+#define COST51_FLOAT_MUL    300
+#endif
+#ifndef COST51_FLOAT_DIV
+#define COST51_FLOAT_DIV    900
+#endif
+#ifndef COST51_POWER
+#define COST51_POWER        6000    // ^, and SIN() and the like
+#endif
+#ifndef COST51_STRING_OP
+#define COST51_STRING_OP    250     // string compare or concatenation
+#endif
+#ifndef COST51_FUNCTION
+#define COST51_FUNCTION     250     // all other functions
+#endif
+
+extern DWORD Cycles51;      // globals.c, wraps
+
+#define COST51(n)  (Cycles51 += (DWORD)(n))
+
+#else
+
+#define COST51(n)
+
+#endif
+
+#endif
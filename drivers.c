@@ -32,8 +32,9 @@ the hardware its running on.
 
 
 #include "bas51.h"
+#include "cost51.h"
 
-extern BIT  StreamDirtyFlag;
+void StreamWriteThrough(WORD addr, BYTE *Src, WORD Len);  // memory.c
 
 // Hardware drivers to interface actual hardware or simulation
 
@@ -46,7 +47,11 @@ extern BIT  StreamDirtyFlag;
 extern BYTE FontLines[14][256]; // The actual FONT used for memory mapped display
 //extern HDC G_hdc;
 extern BIT ForcePaintFlag;
+#ifdef FLAT_MEMORY
+BYTE MemBuf[0x10000];         // Simulates 64K external spi RAM, see memory.c
+#else
 static BYTE MemBuf[0x10000];  // Simulates 64K external spi RAM
+#endif
 static BYTE LastScrn[64*25];  // Used to simulate memory maped display
 extern FLOAT WinScaleX, WinScaleY;
 
@@ -58,6 +63,7 @@ extern FLOAT WinScaleX, WinScaleY;
 // Len = 0 is interpreted as Len = 256
 void ReadBlock51(BYTE *dest, WORD addr, BYTE Len)
 {
+    COST51(COST51_SPI_SETUP + (Len ? Len : 256) * COST51_SPI_BYTE);
     memcpy(dest, &MemBuf[addr], Len ? Len : 256 );
 }
 
@@ -65,9 +71,8 @@ void ReadBlock51(BYTE *dest, WORD addr, BYTE Len)
 // Len = 0 is interpreted as Len = 256
 void WriteBlock51(WORD addr, BYTE *src, BYTE Len)
 {
-    if (addr < BasicVars.VarStart ||
-        addr >= BasicVars.CmdLine) StreamDirtyFlag = TRUE;
-
+    COST51(COST51_SPI_SETUP + (Len ? Len : 256) * COST51_SPI_BYTE);
+    StreamWriteThrough(addr, src, (WORD)(Len ? Len : 256));
     memcpy(&MemBuf[addr], src, Len ? Len : 256);
 }
 
@@ -76,6 +81,8 @@ void WriteBlock51(WORD addr, BYTE *src, BYTE Len)
 
 void MemClear51(WORD Dest, WORD Len)
 {
+    COST51(COST51_SPI_SETUP + (DWORD) Len * COST51_SPI_BYTE);
+    StreamWriteThrough(Dest, NULL, Len);
     memset(&MemBuf[Dest], 0, Len);
 }
 
@@ -264,6 +271,16 @@ void InitScreenCount(void)
     ScreenTicks = GetTickCount();
 }
 
+DWORD GetProfileCount(void)   // Return Microseconds, wraps every 71 minutes
+{
+    LARGE_INTEGER Count, Freq;
+
+    QueryPerformanceCounter(&Count);
+    QueryPerformanceFrequency(&Freq);
+    return((DWORD)(Count.QuadPart / Freq.QuadPart * 1000000 +
+                   Count.QuadPart % Freq.QuadPart * 1000000 / Freq.QuadPart));
+}
+
 
 void FindBasFile(BYTE *buffer)
 {
@@ -366,6 +383,22 @@ WORD BasReadByte(void)
     return(w);
 }
 
+// Read up to Len bytes from open file into Buf as they are.
+// Return the number of bytes read, 0 on error or EOF.
+
+WORD BasReadBlock(BYTE *Buf, WORD Len)
+{
+    return((WORD) fread(Buf, 1, Len, bfp));
+}
+
+// Write Len bytes from Buf to open file as they are.
+// Return TRUE on error.
+
+BIT BasWriteBlock(BYTE *Buf, WORD Len)
+{
+    return((BIT)(fwrite(Buf, 1, Len, bfp) != Len));
+}
+
 // Write byte to open file.
 
 void BasWriteByte(BYTE b)
@@ -380,6 +413,404 @@ void BasWriteByte(BYTE b)
 
 
 
+#ifdef __unix__
+
+// Headless POSIX simulation.  The screen is still kept in VIDEO_MEMORY, but
+// everything printed through VGA_putchar() is also copied to stdout.  The
+// keyboard is read from stdin, which may be a terminal, a pipe or a file.
+// This version needs a compiler where long is 32 bits (gcc -m32).
+
+#include <unistd.h>
+#include <termios.h>
+#include <signal.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/select.h>
+#include <time.h>
+
+#ifdef FLAT_MEMORY
+BYTE MemBuf[0x10000];         // Simulates 64K external spi RAM, see memory.c
+#else
+static BYTE MemBuf[0x10000];  // Simulates 64K external spi RAM
+#endif
+static WORD KeyBuf[8];        // Same Q layout as the Win32 version
+static int  KeyIn=0, KeyOut=0;
+static volatile sig_atomic_t SigBreak = 0;
+static struct termios OrgTerm;
+static BIT  TermSaved = FALSE;
+static char *BasFileDir = "./BasFiles/";
+BIT ConsoleEcho = TRUE;       // FALSE to keep screen output off stdout
+
+
+
+// MEMORY
+
+// read a block into buffer - dest <= RAM[addr]
+// Len = 0 is interpreted as Len = 256
+void ReadBlock51(BYTE *dest, WORD addr, BYTE Len)
+{
+    COST51(COST51_SPI_SETUP + (Len ? Len : 256) * COST51_SPI_BYTE);
+    memcpy(dest, &MemBuf[addr], Len ? Len : 256 );
+}
+
+// Write buffer to RAM - RAM[addr] <= src
+// Len = 0 is interpreted as Len = 256
+void WriteBlock51(WORD addr, BYTE *src, BYTE Len)
+{
+    COST51(COST51_SPI_SETUP + (Len ? Len : 256) * COST51_SPI_BYTE);
+    StreamWriteThrough(addr, src, (WORD)(Len ? Len : 256));
+    memcpy(&MemBuf[addr], src, Len ? Len : 256);
+}
+
+// Hardware specific memory clear.
+// Writes Len bytes of zeros to memory starting at Dest.
+
+void MemClear51(WORD Dest, WORD Len)
+{
+    COST51(COST51_SPI_SETUP + (DWORD) Len * COST51_SPI_BYTE);
+    StreamWriteThrough(Dest, NULL, Len);
+    memset(&MemBuf[Dest], 0, Len);
+}
+
+
+
+// SCREEN
+
+// Copy a char sent to the screen out to stdout.  Called from VGA_putchar().
+
+void ConsolePutChar(BYTE ch)
+{
+    if (!ConsoleEcho) return;
+    if (ch == '\r') return;     // VGA '\r' only homes the cursor
+    putchar(ch);
+    if (ch == '\n') fflush(stdout);
+}
+
+
+
+// KEYBOARD
+
+// Restore the terminal to the way we found it.
+
+static void TermRestore(void)
+{
+    fflush(stdout);
+    if (TermSaved) tcsetattr(STDIN_FILENO, TCSANOW, &OrgTerm);
+}
+
+// Ctrl-C arrives as a signal so that CheckBreak() does not need to poll
+// stdin once per line.
+
+static void BreakHandler(int sig)
+{
+    SigBreak = 1;
+}
+
+// Put the terminal (if any) into single key mode and hook up Ctrl-C.
+
+void InitConsole(void)
+{
+    struct termios t;
+
+    signal(SIGINT, BreakHandler);
+
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &OrgTerm)) return;
+    TermSaved = TRUE;
+    atexit(TermRestore);
+
+    t = OrgTerm;
+    t.c_lflag &= ~ICANON;     // keys are available without waiting for enter
+    t.c_cc[VMIN] = 1;
+    t.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &t);
+}
+
+// Read a byte from stdin.  Returns 0xFFFF on EOF.
+// If Wait is FALSE, returns 0xFFFE if nothing is ready.
+
+static WORD ReadConsoleByte(BIT Wait)
+{
+    fd_set fds;
+    struct timeval tv;
+    BYTE b;
+
+    if (!Wait)
+    {
+        FD_ZERO(&fds);
+        FD_SET(STDIN_FILENO, &fds);
+        tv.tv_sec = tv.tv_usec = 0;
+        if (select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) <= 0) return(0xFFFE);
+    }
+
+    if (read(STDIN_FILENO, &b, 1) != 1) return(0xFFFF);
+    return((WORD) b);
+}
+
+// Move whatever is waiting on stdin into the key Q.
+// ANSI cursor key sequences are translated to the KEY51 codes.
+// Once stdin has ended and the Q is empty, it reads as BREAK.
+
+static void PollConsole(void)
+{
+    static BIT EofFlag = FALSE;
+    WORD w;
+
+    while (!EofFlag && ((KeyIn + 1) & 0x07) != KeyOut)
+    {
+        w = ReadConsoleByte(FALSE);
+        if (w == 0xFFFE) break;           // nothing ready
+        if (w == 0xFFFF)                  // end of input
+        {
+            EofFlag = TRUE;
+            break;
+        }
+        else if (w == KEY51_ESC && ReadConsoleByte(FALSE) == '[')
+        {
+            switch (ReadConsoleByte(FALSE))
+            {
+                case 'A': w = KEY51_UP;    break;
+                case 'B': w = KEY51_DOWN;  break;
+                case 'C': w = KEY51_RIGHT; break;
+                case 'D': w = KEY51_LEFT;  break;
+                case 'H': w = KEY51_HOME;  break;
+                case 'F': w = KEY51_END;   break;
+                case '3': ReadConsoleByte(FALSE); w = KEY51_DEL;  break;
+                case '5': ReadConsoleByte(FALSE); w = KEY51_PGUP; break;
+                case '6': ReadConsoleByte(FALSE); w = KEY51_PGDN; break;
+                default: break;
+            }
+        }
+        else if (w == 0x7F) w = '\b';     // DEL key on most terminals
+
+        KeyBuf[KeyIn++] = w;
+        KeyIn &= 0x7;
+    }
+
+    if (EofFlag && KeyIn == KeyOut)
+    {
+        KeyBuf[KeyIn++] = KEY51_BREAK;
+        KeyIn &= 0x7;
+    }
+}
+
+
+// Check for break key pressed
+// If found, return TRUE and clear the Q.
+
+BIT CheckBreak(void)
+{
+    // Ctrl-C comes as SIGINT, the end of stdin as a BREAK in the Q
+    if (KeyIn != KeyOut && KeyBuf[KeyOut] == KEY51_BREAK) SigBreak = 1;
+
+    if (SigBreak)
+    {
+        SigBreak = 0;
+        KeyOut = KeyIn;    // clear Q
+        return(TRUE);
+    }
+
+    return(FALSE);
+}
+
+// Return TRUE if key available
+
+BIT KeyAvailable(void)
+{
+    PollConsole();
+    return((BIT)(KeyIn != KeyOut ? TRUE : FALSE));
+}
+
+// Wait for and Get enhanced key from keyboard.
+// At the end of stdin, a running program gets BREAK and the editor exits.
+// The BREAK also stops the program at the next CheckBreak().
+
+WORD GetKeyWord(void)
+{
+    WORD out;
+
+    while (!KeyAvailable()) SysWait(10);
+    out = KeyBuf[KeyOut++];
+    KeyOut &= 0x7;
+
+    if (out == KEY51_BREAK)
+    {
+        if (!Running) exit(0);
+        SigBreak = 1;
+    }
+
+    return(out);
+}
+
+
+
+// Other
+
+void SysWait(WORD Ms)
+{
+    fflush(stdout);
+    usleep((useconds_t) Ms * 1000);
+}
+
+static DWORD TickCount(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return((DWORD)(tv.tv_sec * 1000 + tv.tv_usec / 1000));
+}
+
+DWORD GetScreenCount(void)   // Return Milliseconds since program was started
+{
+    return(TickCount() - ScreenTicks);
+}
+
+void InitScreenCount(void)
+{
+    ScreenTicks = TickCount();
+}
+
+DWORD GetProfileCount(void)   // Return Microseconds, wraps every 71 minutes
+{
+    struct timespec ts;
+
+    // Monotonic, so a clock change does not upset the profile
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((DWORD) ts.tv_sec * 1000000UL + (DWORD)(ts.tv_nsec / 1000));
+}
+
+
+// Change the directory that the BasFile functions work in.
+// Dir must end with a '/'.
+
+void SetBasFileDir(char *Dir)
+{
+    BasFileDir = Dir;
+}
+
+
+void FindBasFile(BYTE *buffer)
+{
+    static DIR *dp = NULL;
+    struct dirent *de;
+    struct stat st;
+    char FStr[300];
+
+    if (buffer == NULL)   // first call initializes stuff
+    {
+        if (dp) closedir(dp);
+        dp = NULL;
+        return;
+    }
+
+    buffer[0] = 0;
+    if (!dp)           // This is the first call
+    {
+        dp = opendir(BasFileDir);
+        if (!dp) return;    // no files
+    }
+
+    while ((de = readdir(dp)) != NULL)
+    {
+        // skip anything that isn't a regular file
+        sprintf(FStr, "%s%.255s", BasFileDir, de->d_name);
+        if (stat(FStr, &st) == 0 && S_ISREG(st.st_mode)) break;
+    }
+
+    if (de == NULL)   // No more files
+    {
+        closedir(dp);
+        dp = NULL;
+        return;
+    }
+
+    // If we are here, we found a file.
+    strcpy((char *) buffer, de->d_name);
+}
+
+
+static FILE *bfp = NULL;
+
+// Close file if opened
+
+void BasFileClose(void)
+{
+    if (bfp)
+    {
+    	fclose(bfp);    // already open so close
+        bfp = NULL;
+	}
+}
+
+// Open file pointed to by FileName.
+// uData points to filename in secondary RAM.
+// Returns TRUE on error opening file, else FALSE.
+
+BIT BasFileOpen(BIT ReadFlag)
+{
+    char FStr[320];
+    int Len;
+
+    BasFileClose();
+
+    if (!uData.sVal.sPtr) return(TRUE);    // null file name
+    Len = StringLen(UDATA);
+    if (Len == 0 || strlen(BasFileDir) + Len >= sizeof(FStr)) return(TRUE);
+    memset(FStr, 0, sizeof(FStr));
+    strcpy(FStr, BasFileDir);
+    ReadBlock51((BYTE *) FStr + strlen(FStr),
+    		(WORD)(uData.sVal.sPtr), (BYTE) Len);
+
+    bfp = fopen(FStr, ReadFlag ? "rb" : "wb");
+
+    return((BIT)(bfp ? FALSE : TRUE));
+}
+
+// Read next byte from open file.  Return 0xFFFF on error or EOF.
+
+WORD BasReadByte(void)
+{
+    WORD w;
+
+    do
+    {
+        w = (WORD) fgetc(bfp);
+    } while (w == '\r');     // ignore returns
+
+    return(w);
+}
+
+// Read up to Len bytes from open file into Buf as they are.
+// Return the number of bytes read, 0 on error or EOF.
+
+WORD BasReadBlock(BYTE *Buf, WORD Len)
+{
+    return((WORD) fread(Buf, 1, Len, bfp));
+}
+
+// Write Len bytes from Buf to open file as they are.
+// Return TRUE on error.
+
+BIT BasWriteBlock(BYTE *Buf, WORD Len)
+{
+    return((BIT)(fwrite(Buf, 1, Len, bfp) != Len));
+}
+
+// Write byte to open file.  Files keep the DOS line endings the Win32
+// version writes so they can be moved between the two.
+
+void BasWriteByte(BYTE b)
+{
+    if (b == '\n') fputc('\r',bfp);
+    fputc(b, bfp);
+}
+
+
+#endif   // __unix__
+
+
+
+
 
 
 
@@ -407,8 +838,7 @@ void ReadBlock51(BYTE *dest, WORD addr, BYTE Len)
 // Len = 0 is interpreted as Len = 256
 void WriteBlock51(WORD addr, BYTE *src, BYTE Len)
 {
-    if (addr < BasicVars.VarStart ||
-        addr >= BasicVars.CmdLine) StreamDirtyFlag = TRUE;
+    StreamWriteThrough(addr, src, (WORD)(Len ? Len : 256));
 
 //
 }
@@ -418,6 +848,8 @@ void WriteBlock51(WORD addr, BYTE *src, BYTE Len)
 
 void MemClear51(WORD Dest, WORD Len)
 {
+    StreamWriteThrough(Dest, NULL, Len);
+
 //
 }
 
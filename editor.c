@@ -30,6 +30,11 @@ EDITOR.C - Line editor routines.
 
 
 #include "bas51.h"
+#include "stats.h"
+
+void UnlinkProgram(void);   // flow_cmds.c
+void ClearExprCache(void);  // expression.c
+void ClearVMCache(void);    // command.c
 
 // This is the main line editor routine.
 // The line is accepted and added to the code file.
@@ -274,6 +279,151 @@ WORD EditBasicLine(WORD LinePtr)
 }
 
 
+// LINE INDEX
+// FindLinePtr() used to walk the whole program for every GOTO and GOSUB.
+// Now it does a binary search of a sorted table of line numbers and their
+// addresses, then walks forward from there.  If the program has more lines
+// than the table holds, only every LineIdxStride'th line is in it and the
+// walk is at most that many lines long.  The table is built on the first
+// lookup after it was invalidated.  Adding or deleting a single line keeps
+// it up to date when every line is in it, anything else just invalidates it.
+// Lines that LOAD adds to the end of the program are always kept, halving
+// the table and doubling the stride when it fills.
+
+#ifndef LINE_INDEX_SIZE
+#ifdef __C51__
+#define LINE_INDEX_SIZE  64
+#else
+#define LINE_INDEX_SIZE  2048
+#endif
+#endif
+
+XDATA WORD LineIdxNum[LINE_INDEX_SIZE];   // Line numbers in ascending order
+XDATA WORD LineIdxAddr[LINE_INDEX_SIZE];  // Address of each line
+WORD LineIdxCount;                        // Entries in use
+WORD LineIdxStride;                       // Lines per entry, 0 = invalid
+WORD LineIdxSkip;                         // Lines after the last entry
+
+
+// Force a rebuild of the index at the next lookup.
+// Called whenever line numbers or line addresses change wholesale.
+
+void InvalidateLineIndex(void)
+{
+    LineIdxStride = 0;
+}
+
+
+// Walk the program and fill in the index.
+
+void BuildLineIndex(void)
+{
+    WORD addr, Lines;
+
+    // Count the lines to work out the stride
+    Lines = 0;
+    for (addr = BasicVars.ProgStart; addr < BasicVars.VarStart;
+         addr += (WORD)(ReadRandom51((WORD)(addr + 2)) + 3))
+        Lines++;
+    LineIdxStride = (WORD)(Lines / LINE_INDEX_SIZE + 1);
+
+    LineIdxCount = 0;
+    Lines = 0;
+    for (addr = BasicVars.ProgStart; addr < BasicVars.VarStart;
+         addr += (WORD)(ReadRandom51((WORD)(addr + 2)) + 3))
+    {
+        LineIdxSkip = (WORD)(Lines++ % LineIdxStride);
+        if (LineIdxSkip) continue;
+        LineIdxNum[LineIdxCount] = ReadRandomWord(addr);
+        LineIdxAddr[LineIdxCount++] = addr;
+    }
+}
+
+
+// Return the index of the first entry with an address >= addr.
+
+static WORD FindLineIndexAddr(WORD addr)
+{
+    WORD Lo, Hi, Mid;
+
+    Lo = 0;
+    Hi = LineIdxCount;
+    while (Lo < Hi)
+    {
+        Mid = (WORD)((Lo + Hi) >> 1);
+        if (LineIdxAddr[Mid] < addr) Lo = (WORD)(Mid + 1);
+        else Hi = Mid;
+    }
+    return(Lo);
+}
+
+
+// Update the index for a line of Len bytes that was just inserted at
+// LinePtr (Len > 0) or is about to be deleted from there (Len < 0).
+
+static void AdjustLineIndex(WORD LinePtr, WORD Line, int Len)
+{
+    WORD i, n;
+
+    if (LineIdxStride != 1) goto Invalidate;
+
+    i = FindLineIndexAddr(LinePtr);
+    if (Len < 0)   // delete entry i
+    {
+        if (i == LineIdxCount || LineIdxAddr[i] != LinePtr) goto Invalidate;
+        LineIdxCount--;
+        for (n = i; n != LineIdxCount; n++)
+        {
+            LineIdxNum[n] = LineIdxNum[n + 1];
+            LineIdxAddr[n] = (WORD)(LineIdxAddr[n + 1] + Len);
+        }
+    }
+    else           // insert new entry at i
+    {
+        if (LineIdxCount == LINE_INDEX_SIZE) goto Invalidate;
+        for (n = LineIdxCount; n != i; n--)
+        {
+            LineIdxNum[n] = LineIdxNum[n - 1];
+            LineIdxAddr[n] = (WORD)(LineIdxAddr[n - 1] + Len);
+        }
+        LineIdxNum[i] = Line;
+        LineIdxAddr[i] = LinePtr;
+        LineIdxCount++;
+    }
+    return;
+
+Invalidate:
+    InvalidateLineIndex();
+}
+
+
+// Add a line that was just stored at the end of the program.  When the
+// table is full every other entry is dropped and the stride doubles.
+
+static void AppendLineIndex(WORD LinePtr, WORD Line)
+{
+    WORD n;
+
+    if (LineIdxStride == 0) return;    // built at the next lookup
+    if (LineIdxCount && ++LineIdxSkip != LineIdxStride) return;
+
+    if (LineIdxCount == LINE_INDEX_SIZE)
+    {
+        for (n = 0; n != LINE_INDEX_SIZE / 2; n++)
+        {
+            LineIdxNum[n] = LineIdxNum[n * 2];
+            LineIdxAddr[n] = LineIdxAddr[n * 2];
+        }
+        LineIdxCount = LINE_INDEX_SIZE / 2;
+        LineIdxStride *= 2;
+    }
+
+    LineIdxSkip = 0;
+    LineIdxNum[LineIdxCount] = Line;
+    LineIdxAddr[LineIdxCount++] = LinePtr;
+}
+
+
 // Scan the file and look for the specified line number.
 // If ExactFlag = TRUE, LineNum must be an exact match.
 // If ExactFlag = FALSE, will return LineNum if its there or the next line
@@ -286,13 +436,31 @@ WORD FindLinePtr(WORD LineNum, BIT ExactFlag)
     BYTE Len;
     WORD addr;
     WORD Line;
+    WORD Lo, Hi, Mid;
 
-    addr = BasicVars.ProgStart;  // start program after basic vars
+    STAT_INC(STAT_FIND_LINE);
+    if (LineIdxStride == 0) BuildLineIndex();
+
+    // Find the last entry with a line number <= LineNum
+    Lo = 0;
+    Hi = LineIdxCount;
+    while (Lo < Hi)
+    {
+        Mid = (WORD)((Lo + Hi) >> 1);
+        if (LineIdxNum[Mid] <= LineNum) Lo = (WORD)(Mid + 1);
+        else Hi = Mid;
+    }
+
+    // Start walking from there
+    if (Lo == 0) addr = BasicVars.ProgStart;  // start program after basic vars
+    else addr = LineIdxAddr[Lo - 1];
 
     while (addr < BasicVars.VarStart)
     {
-        Line = (WORD)((ReadRandom51(addr++) << 8) | ReadRandom51(addr++));
-        Len = (BYTE) ReadRandom51(addr++);
+        STAT_INC(STAT_LINES_SCANNED);
+        Line = ReadRandomWord(addr);
+        Len = (BYTE) ReadRandom51((WORD)(addr + 2));
+        addr += (WORD) 3;
         if (Line >= LineNum)
         {
             if (!ExactFlag || Line == LineNum) return((WORD)(addr - 3));
@@ -311,6 +479,7 @@ void DeleteLine(WORD LinePtr)
     BYTE Len;
 
 	Len = (BYTE)(ReadRandom51((WORD)(LinePtr + 2)) + 3);
+    AdjustLineIndex(LinePtr, 0, -(int) Len);
     Src = (WORD)(LinePtr + Len);
     MemMove51(LinePtr, Src, (WORD)(BasicVars.VarStart - Src));
     BasicVars.VarStart -= Len;
@@ -332,6 +501,10 @@ void DeleteLineRange(WORD StartLine, WORD EndLine)
     if (StartLine == 0 && EndLine == MAX_LINE_NUMBER) return;
     if (StartLine > EndLine) return;  // not an error but nothing to do
 
+    UnlinkProgram();   // line addresses are about to change
+    ClearExprCache();
+    ClearVMCache();
+
     // Get pointer to starting line
     if (StartLine == 0)
         StartLine = BasicVars.ProgStart;
@@ -346,6 +519,7 @@ void DeleteLineRange(WORD StartLine, WORD EndLine)
     Len = (WORD)(BasicVars.VarStart - EndLine);
     MemMove51(StartLine, EndLine, Len);
     BasicVars.VarStart -= (WORD)(EndLine - StartLine);
+    InvalidateLineIndex();
     ClearVariables();
 
     return;
@@ -377,7 +551,9 @@ WORD StoreBasicLine(WORD LinePtr)
         WriteBlock51(BasicVars.CmdLine, (BYTE *) TokBuf, (BYTE) sizeof(TokBuf));
         return(0xFFFF);   // Indicate that line is to be Executed immediately.
     }
-    // StreamDirtyFlag = TRUE;
+    UnlinkProgram();   // line addresses are about to change
+    ClearExprCache();
+    ClearVMCache();
 
     // If No pre-existing line pointer supplied, search for it.
     if (LinePtr == NULL)
@@ -428,6 +604,7 @@ WORD StoreBasicLine(WORD LinePtr)
 	    // Copy New Line In
 	    WriteBlock51(LinePtr, (BYTE *) TokBuf, Len);
 	    BasicVars.VarStart += Len;
+        AdjustLineIndex(LinePtr, Line, Len);
     }
 
 Error:
@@ -437,6 +614,195 @@ Error:
 
 }
 
+
+// BULK LOAD
+// LOAD used to store every line with StoreBasicLine(), which looks the line
+// up twice, opens a gap for it and clears the variables each time.  Since a
+// file is nearly always in line number order, the loader instead appends a
+// line straight onto the end of the program when it is higher than every
+// line stored so far.  Lines that are out of order are kept in a sorted
+// pending table and merged into the program in one pass when the table
+// fills or the load ends.  As with StoreBasicLine(), a later line replaces
+// an earlier one with the same number.  The variables are cleared once at
+// the end.
+
+#ifndef BULK_PEND_SIZE
+#ifdef __C51__
+#define BULK_PEND_SIZE  256
+#else
+#define BULK_PEND_SIZE  16384
+#endif
+#endif
+
+#define BULK_PEND_MAX   (BULK_PEND_SIZE / 5)   // shortest line is 5 bytes
+
+XDATA BYTE BulkPend[BULK_PEND_SIZE];      // pending lines as tokenized
+XDATA WORD BulkPendOfs[BULK_PEND_MAX];    // their offsets in line order
+WORD BulkPendBytes, BulkPendCount;
+WORD BulkTopLine;                         // highest line stored so far
+
+
+// Line number of the i'th pending line.
+
+static WORD BulkPendLine(WORD i)
+{
+    BYTE *p;
+
+    p = &BulkPend[BulkPendOfs[i]];
+    return((WORD)((p[0] << 8) | p[1]));
+}
+
+
+// Return the index of the first pending line numbered higher than Line.
+
+static WORD FindBulkPend(WORD Line)
+{
+    WORD Lo, Hi, Mid;
+
+    Lo = 0;
+    Hi = BulkPendCount;
+    while (Lo < Hi)
+    {
+        Mid = (WORD)((Lo + Hi) >> 1);
+        if (BulkPendLine(Mid) <= Line) Lo = (WORD)(Mid + 1);
+        else Hi = Mid;
+    }
+    return(Lo);
+}
+
+
+// Merge the pending lines into the program.  The program is moved up by
+// the size of the pending lines, then the two are merged back down from
+// the start.  The write address can never pass the read address.
+
+static void MergeBulkPend(void)
+{
+    WORD Src, End, Dst, i, Line, PendLine;
+    BYTE Len;
+
+    if (BulkPendCount == 0) return;
+
+    Src = (WORD)(BasicVars.ProgStart + BulkPendBytes);
+    End = (WORD)(BasicVars.VarStart + BulkPendBytes);
+    MemMove51(Src, BasicVars.ProgStart, (WORD)(BasicVars.VarStart - BasicVars.ProgStart));
+
+    Dst = BasicVars.ProgStart;
+    i = 0;
+    while (Src < End || i < BulkPendCount)
+    {
+        // Only the last of several pending lines with one number is kept
+        if (i < BulkPendCount)
+        {
+            PendLine = BulkPendLine(i);
+            if (i + 1 < BulkPendCount && BulkPendLine(i + 1) == PendLine)
+            {
+                i++;
+                continue;
+            }
+        }
+
+        if (Src < End)
+        {
+            Line = ReadRandomWord(Src);
+            Len = (BYTE)(ReadRandom51((WORD)(Src + 2)) + 3);
+            if (i == BulkPendCount || Line < PendLine)
+            {
+                MemMove51(Dst, Src, Len);   // keep the program line
+                Src += Len;
+                Dst += Len;
+                continue;
+            }
+            if (Line == PendLine) Src += Len;   // replaced by pending line
+        }
+
+        Len = (BYTE)(BulkPend[BulkPendOfs[i] + 2] + 3);
+        WriteBlock51(Dst, &BulkPend[BulkPendOfs[i]], Len);
+        Dst += Len;
+        i++;
+    }
+
+    BasicVars.VarStart = Dst;
+    BulkPendBytes = BulkPendCount = 0;
+    BuildLineIndex();    // kept up to date by the appends that follow
+}
+
+
+// Get ready to load a program into the (empty) program space.
+
+void StartBulkLoad(void)
+{
+    BulkPendBytes = BulkPendCount = 0;
+    BulkTopLine = 0;
+}
+
+
+// Return TRUE if line number Line has already been loaded.
+
+BIT BulkLineExists(WORD Line)
+{
+    WORD i;
+
+    if (Line > BulkTopLine) return(FALSE);
+    if (FindLinePtr(Line, TRUE)) return(TRUE);
+
+    i = FindBulkPend(Line);
+    return((BIT)(i && BulkPendLine((WORD)(i - 1)) == Line));
+}
+
+
+// Store the line in TokBuf[] for LOAD.  Lines are never blank here.
+// Returns TRUE with SyntaxErrorCode set if there is no room for it.
+
+BIT BulkStoreLine(void)
+{
+    WORD Line, i;
+    BYTE Len;
+
+    Line = (WORD)((TokBuf[0] << 8) | TokBuf[1]);
+    Len = (BYTE)(TokBuf[2] + 3);
+
+    if ((WORD)(BasicVars.StringBot - BasicVars.VarStart - BulkPendBytes) < Len)
+    {
+        SyntaxErrorCode = ERROR_INSUFFICIENT_MEMORY;
+        return(TRUE);
+    }
+
+    // The normal case.  Add the line to the end of the program.
+    if (Line > BulkTopLine ||
+        (BasicVars.VarStart == BasicVars.ProgStart && BulkPendCount == 0))
+    {
+        WriteBlock51(BasicVars.VarStart, (BYTE *) TokBuf, Len);
+        AppendLineIndex(BasicVars.VarStart, Line);
+        BasicVars.VarStart += Len;
+        BulkTopLine = Line;
+        return(FALSE);
+    }
+
+    // Out of order.  Insert it after any pending line with the same number.
+    if (BulkPendCount == BULK_PEND_MAX ||
+        BulkPendBytes + Len > BULK_PEND_SIZE)
+        MergeBulkPend();
+
+    i = FindBulkPend(Line);
+    memmove(&BulkPendOfs[i + 1], &BulkPendOfs[i],
+            (BulkPendCount - i) * sizeof(BulkPendOfs[0]));
+    BulkPendOfs[i] = BulkPendBytes;
+    BulkPendCount++;
+    memcpy(&BulkPend[BulkPendBytes], TokBuf, Len);
+    BulkPendBytes += Len;
+    return(FALSE);
+}
+
+
+// Finish a load.  Merge in any lines that were out of order and reset the
+// variable area.
+
+void EndBulkLoad(void)
+{
+    MergeBulkPend();
+    ClearVariables();
+}
+
 // Get an input line starting at the current cursor location
 
 void GetInputLine(void)
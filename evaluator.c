@@ -31,6 +31,7 @@ BASIC operators.
 
 
 #include "bas51.h"
+#include "cost51.h"
 #include <math.h>
 
 
@@ -44,80 +45,40 @@ float FloatMod(float a, float b)
 }
 
 
-void Evaluate(BYTE OperatorToken)
-{
-    BIT  UnaryFlag, FloatFlag, StringFlag;
+#ifdef BAS51_COST
 
-    UnaryFlag = FALSE;
-    FloatFlag = FALSE;
-    StringFlag = FALSE;
+// Estimated 8051 cycles for an operator on arguments of type Type,
+// which is TOKEN_INTL_CONST, TOKEN_FLOAT_CONST or TOKEN_STRING_CONST.
 
-    // Figure out how many parameters
-    if (OperatorToken == TOKEN_NOT || OperatorToken == TOKEN_UNARY_MINUS)
-        UnaryFlag = TRUE;
-
-    // Pop the arguments
-    uValTok[1] = PopStk(CALC_STACK);     // second parameter first
-    uValArg[1] = uData;
+WORD OpCost51(BYTE Op, BYTE Type)
+{
+    if (Type == TOKEN_STRING_CONST) return(COST51_STRING_OP);
+    if (Op == TOKEN_POWER) return(COST51_POWER);
 
-    uValTok[0] = 0;
-    if (!UnaryFlag)
+    if (Type == TOKEN_FLOAT_CONST)
     {
-        uValTok[0] = PopStk(CALC_STACK);    // Pop first parameter if not unary
-        uValArg[0] = uData;
+        if (Op == TOKEN_MULTIPLY) return(COST51_FLOAT_MUL);
+        if (Op == TOKEN_DIVIDE || Op == TOKEN_MOD) return(COST51_FLOAT_DIV);
+        return(COST51_FLOAT_OP);
     }
 
-    // special case for assignment
-    if (OperatorToken == TOKEN_ASSIGN)
-    {
-        // modify compatible types
-        if (uValTok[0] == TOKEN_INTL_VAR && uValTok[1] == TOKEN_FLOAT_CONST)
-        {
-            // change float to int
-            uValArg[1].LVal = uValArg[1].fVal;
-            uValTok[1] = TOKEN_INTL_CONST;
-        }
-        else if (uValTok[0] == TOKEN_FLOAT_VAR && uValTok[1] == TOKEN_INTL_CONST)
-        {
-            // change float to int
-            uValArg[1].fVal = uValArg[1].LVal;
-            uValTok[1] = TOKEN_FLOAT_CONST;
-        }
+    if (Op == TOKEN_MULTIPLY) return(COST51_INT_MUL);
+    if (Op == TOKEN_DIVIDE || Op == TOKEN_MOD) return(COST51_INT_DIV);
+    return(COST51_INT_OP);
+}
 
-        // check for compatable assignment
-        if (uValTok[0] != uValTok[1] + 4) goto Error1;
+#endif
 
-        // Make assignment
-        uData = uValArg[1];
-        WriteVar(uValTok[0], uValArg[0].sVal.sPtr);
 
-        return;
-    }
-
-    // Check for any strings
-    if (uValTok[0] == TOKEN_STRING_CONST || uValTok[1] == TOKEN_STRING_CONST)
-    {
-        // only certain operators are allowed for string parameters
-        if (OperatorToken >= TOKEN_EQUALS && OperatorToken <= TOKEN_PLUS)
-        {
-        	StringFlag = TRUE;
-        }
-        else goto Error1;
-
-        if (uValTok[0] != uValTok[1]) goto Error1;   // The both must be strings
-    }
-
-    // Check for float arguments
-    if (uValTok[0] == TOKEN_FLOAT_CONST || uValTok[1] == TOKEN_FLOAT_CONST)
-    {
-        // advance ints to floats
-        if (uValTok[0] == TOKEN_INTL_CONST)
-            uValArg[0].fVal = uValArg[0].LVal;
-        if (uValTok[1] == TOKEN_INTL_CONST)
-            uValArg[1].fVal = uValArg[1].LVal;
+// Apply a numeric operator to uValArg[0] and uValArg[1], which are both
+// float if FloatFlag, otherwise both INTL.  Unary operators only use
+// uValArg[1].  The result is left in uData.  Returns TRUE on divide by
+// zero.  Shared by Evaluate() and the statement VM.
 
-        FloatFlag = TRUE;
-    }
+BIT NumericOp(BYTE OperatorToken, BIT FloatFlag)
+{
+    COST51(OpCost51(OperatorToken,
+        (BYTE)(FloatFlag ? TOKEN_FLOAT_CONST : TOKEN_INTL_CONST)));
 
     uData.fVal = 0;
     if (FloatFlag)
@@ -191,49 +152,6 @@ void Evaluate(BYTE OperatorToken)
                 break;
 
         }
-
-        PushStk(CALC_STACK, TOKEN_FLOAT_CONST);
-    }
-    else if (StringFlag)
-    {
-        uData.LVal = 0;   // FALSE
-        switch (OperatorToken)
-        {
-            case TOKEN_PLUS:
-                ConcatStr();
- 				if (SyntaxErrorCode) return;
-                PushStk(CALC_STACK, TOKEN_STRING_CONST);
-                return;
-
-			case TOKEN_EQUALS:
-                if (StringCmp() == 0) uData.LVal = -1; // TRUE
-                break;
-
-			case TOKEN_NOT_EQUAL:
-                if (StringCmp() != 0) uData.LVal = -1; // TRUE
-                break;
-
-			case TOKEN_LESS_THAN_OR_EQUAL:
-                if (StringCmp() <= 0) uData.LVal = -1; // TRUE
-                break;
-
-			case TOKEN_GREATER_THAN_OR_EQUAL:
-                if (StringCmp() >= 0) uData.LVal = -1; // TRUE
-                break;
-
-			case TOKEN_GREATER_THAN:
-                if (StringCmp() > 0) uData.LVal = -1; // TRUE
-                break;
-
-			case TOKEN_LESS_THAN:
-                if (StringCmp() < 0) uData.LVal = -1; // TRUE
-                break;
-
-            default:
-                goto Error1;  // operator type conflict
-        }
-
-        PushStk(CALC_STACK, TOKEN_INTL_CONST);
     }
     else  // must be INTL
     {
@@ -306,18 +224,145 @@ void Evaluate(BYTE OperatorToken)
                 break;
 
         }
+    }
+
+    return(FALSE);
+
+Error2:
+    SyntaxErrorCode = ERROR_DIVIDE_BY_ZERO;
+    return(TRUE);
+}
+
+
+void Evaluate(BYTE OperatorToken)
+{
+    BIT  UnaryFlag, FloatFlag, StringFlag;
+
+    UnaryFlag = FALSE;
+    FloatFlag = FALSE;
+    StringFlag = FALSE;
+
+    // Figure out how many parameters
+    if (OperatorToken == TOKEN_NOT || OperatorToken == TOKEN_UNARY_MINUS)
+        UnaryFlag = TRUE;
+
+    // Pop the arguments
+    uValTok[1] = PopStk(CALC_STACK);     // second parameter first
+    uValArg[1] = uData;
+
+    uValTok[0] = 0;
+    if (!UnaryFlag)
+    {
+        uValTok[0] = PopStk(CALC_STACK);    // Pop first parameter if not unary
+        uValArg[0] = uData;
+    }
+
+    // special case for assignment
+    if (OperatorToken == TOKEN_ASSIGN)
+    {
+        // modify compatible types
+        if (uValTok[0] == TOKEN_INTL_VAR && uValTok[1] == TOKEN_FLOAT_CONST)
+        {
+            // change float to int
+            uValArg[1].LVal = uValArg[1].fVal;
+            uValTok[1] = TOKEN_INTL_CONST;
+        }
+        else if (uValTok[0] == TOKEN_FLOAT_VAR && uValTok[1] == TOKEN_INTL_CONST)
+        {
+            // change float to int
+            uValArg[1].fVal = uValArg[1].LVal;
+            uValTok[1] = TOKEN_FLOAT_CONST;
+        }
+
+        // check for compatable assignment
+        if (uValTok[0] != uValTok[1] + 4) goto Error1;
+
+        // Make assignment
+        COST51(COST51_INT_OP);
+        uData = uValArg[1];
+        WriteVar(uValTok[0], uValArg[0].sVal.sPtr);
+
+        return;
+    }
+
+    // Check for any strings
+    if (uValTok[0] == TOKEN_STRING_CONST || uValTok[1] == TOKEN_STRING_CONST)
+    {
+        // only certain operators are allowed for string parameters
+        if (OperatorToken >= TOKEN_EQUALS && OperatorToken <= TOKEN_PLUS)
+        {
+        	StringFlag = TRUE;
+        }
+        else goto Error1;
+
+        if (uValTok[0] != uValTok[1]) goto Error1;   // The both must be strings
+    }
+
+    // Check for float arguments
+    if (uValTok[0] == TOKEN_FLOAT_CONST || uValTok[1] == TOKEN_FLOAT_CONST)
+    {
+        // advance ints to floats
+        if (uValTok[0] == TOKEN_INTL_CONST)
+            uValArg[0].fVal = uValArg[0].LVal;
+        if (uValTok[1] == TOKEN_INTL_CONST)
+            uValArg[1].fVal = uValArg[1].LVal;
+
+        FloatFlag = TRUE;
+    }
+
+    if (StringFlag)
+    {
+        COST51(OpCost51(OperatorToken, TOKEN_STRING_CONST));
+        uData.LVal = 0;   // FALSE
+        switch (OperatorToken)
+        {
+            case TOKEN_PLUS:
+                ConcatStr();
+ 				if (SyntaxErrorCode) return;
+                PushStk(CALC_STACK, TOKEN_STRING_CONST);
+                return;
+
+			case TOKEN_EQUALS:
+                if (StringCmp() == 0) uData.LVal = -1; // TRUE
+                break;
+
+			case TOKEN_NOT_EQUAL:
+                if (StringCmp() != 0) uData.LVal = -1; // TRUE
+                break;
+
+			case TOKEN_LESS_THAN_OR_EQUAL:
+                if (StringCmp() <= 0) uData.LVal = -1; // TRUE
+                break;
+
+			case TOKEN_GREATER_THAN_OR_EQUAL:
+                if (StringCmp() >= 0) uData.LVal = -1; // TRUE
+                break;
+
+			case TOKEN_GREATER_THAN:
+                if (StringCmp() > 0) uData.LVal = -1; // TRUE
+                break;
+
+			case TOKEN_LESS_THAN:
+                if (StringCmp() < 0) uData.LVal = -1; // TRUE
+                break;
+
+            default:
+                goto Error1;  // operator type conflict
+        }
+
         PushStk(CALC_STACK, TOKEN_INTL_CONST);
+        return;
     }
 
+    if (NumericOp(OperatorToken, FloatFlag)) return;   // divide by zero
+    PushStk(CALC_STACK, (BYTE)(FloatFlag ? TOKEN_FLOAT_CONST : TOKEN_INTL_CONST));
+
     return;
 
 Error1:
     SyntaxErrorCode = ERROR_TYPE_CONFLICT;
     return;
 
-Error2:
-    SyntaxErrorCode = ERROR_DIVIDE_BY_ZERO;
-    return;
 
 
 }
@@ -417,6 +462,10 @@ void EvaluateFunction(BYTE FunctionToken, BYTE NumParams)
 
     uData.LVal = 0;   // default return value
 
+    // ATN() to TAN() are the float library's slow ones
+    COST51(FunctionToken >= TOKEN_ATN && FunctionToken <= TOKEN_TAN ?
+           COST51_POWER : COST51_FUNCTION);
+
     // Calculate the number of required parameters
     if (FunctionToken <= TOKEN_TIMETICKS) ReqParams = 0;
     else if (FunctionToken <= TOKEN_TAB) ReqParams = 1;
@@ -30,6 +30,9 @@ to avoid the use of recursive functions for the 8051's benefit.
 */
 
 #include "bas51.h"
+#include "cost51.h"
+
+BIT NumericOp(BYTE OperatorToken, BIT FloatFlag);   // evaluator.c
 
 
 
@@ -102,6 +105,489 @@ BYTE ClassifyToken(BYTE Token)
 
 
 
+// COMPILED EXPRESSIONS
+// Expression() below runs the whole shunting yard algorithm each time a
+// statement executes, but what it does only depends on the tokens, never on
+// the values.  So the first time an expression in the program is evaluated,
+// every step it takes is recorded in postfix order in ExprCode[].  After
+// that, RunExprCode() just replays the steps on the calc stack.  Constants
+// and variables are still read from the program, by address, so linked line
+// numbers and the variable cache work the same either way.  Expressions
+// that fail are not recorded.  The code is thrown away whenever the program
+// changes.  There isn't room for this on the 8051.
+
+#ifndef __C51__
+#define EXPR_COMPILE
+#endif
+
+#ifdef EXPR_COMPILE
+
+#ifndef EXPR_CODE_SIZE
+#define EXPR_CODE_SIZE   16384
+#endif
+
+#ifndef EXPR_INDEX_SIZE
+#define EXPR_INDEX_SIZE  512     // must be a power of 2
+#endif
+
+#define EXPR_CODE_MIN    1024    // room needed to record a new expression
+
+#define EXPR_SLOT(Addr)  ((WORD)(((Addr) ^ ((Addr) >> 6)) & (EXPR_INDEX_SIZE - 1)))
+
+// Every step is four bytes: Op, Arg, Address MSB, Address LSB.
+// Each expression starts with a header: Flags, Stop Token, End Address.
+enum { EXPR_END, EXPR_CONST, EXPR_VAR, EXPR_LETVAR, EXPR_ARRAY,
+       EXPR_ELEMENT, EXPR_ARRAYVAL, EXPR_FUNC, EXPR_OP };
+
+XDATA BYTE ExprCode[EXPR_CODE_SIZE];
+XDATA WORD ExprIdxAddr[EXPR_INDEX_SIZE];   // Program address of expression
+XDATA WORD ExprIdxCode[EXPR_INDEX_SIZE];   // Offset in ExprCode[] + 1
+WORD ExprCodeUsed;
+WORD ExprRecPtr;          // Where the next step is recorded
+WORD ExprRecAddr;         // Program address of the one being recorded
+WORD ExprRecSlot;         // and its index slot
+BIT ExprRecording;
+
+
+// Throw away all compiled expressions.
+// Called whenever the program changes.
+
+void ClearExprCache(void)
+{
+    WORD i;
+
+    for (i = 0; i != EXPR_INDEX_SIZE; i++) ExprIdxCode[i] = 0;
+    ExprCodeUsed = 0;
+    ExprRecording = FALSE;
+}
+
+// Record one step of the expression being evaluated.
+
+void ExprEmit(BYTE Op, BYTE Arg, WORD Addr)
+{
+    if (!ExprRecording) return;
+
+    if (ExprRecPtr > EXPR_CODE_SIZE - 8)   // leave room for EXPR_END
+    {
+        ExprRecording = FALSE;    // too big, give up on this one
+        return;
+    }
+
+    ExprCode[ExprRecPtr++] = Op;
+    ExprCode[ExprRecPtr++] = Arg;
+    ExprCode[ExprRecPtr++] = (BYTE)(Addr >> 8);
+    ExprCode[ExprRecPtr++] = (BYTE)(Addr & 0xFF);
+}
+
+
+// Called at the start of Expression() with the stream at the first token.
+// Return the offset of the compiled code, or 0 if there isn't any, in
+// which case recording is started if the expression can be compiled.
+
+WORD StartExprCode(BYTE Flags)
+{
+    WORD Addr, Code;
+
+    ExprRecording = FALSE;
+    Addr = GetStreamAddr();
+    ExprRecAddr = Addr;
+
+    // Only expressions in the program, DIM only runs once anyway
+    if (Addr < BasicVars.ProgStart || Addr >= BasicVars.VarStart ||
+        (Flags & EXPRESSION_DIM_FLAG))
+        return(0);
+
+    ExprRecSlot = EXPR_SLOT(Addr);
+    Code = ExprIdxCode[ExprRecSlot];
+    if (Code && ExprIdxAddr[ExprRecSlot] == Addr && ExprCode[Code - 1] == Flags)
+        return(Code);
+
+    if (EXPR_CODE_SIZE - ExprCodeUsed < EXPR_CODE_MIN) ClearExprCache();
+
+    // Start recording after the header
+    ExprCode[ExprCodeUsed] = Flags;
+    ExprRecPtr = (WORD)(ExprCodeUsed + 4);
+    ExprRecording = TRUE;
+
+    return(0);
+}
+
+
+// Called at the end of Expression() with the token that stopped it.
+// If the expression was recorded without error, add it to the index.
+
+void EndExprCode(BYTE Token)
+{
+    WORD Addr;
+
+    ExprEmit(EXPR_END, 0, 0);
+    if (!ExprRecording || SyntaxErrorCode) return;
+    ExprRecording = FALSE;
+
+    // Fill in the header
+    Addr = GetStreamAddr();
+    ExprCode[ExprCodeUsed + 1] = Token;
+    ExprCode[ExprCodeUsed + 2] = (BYTE)(Addr >> 8);
+    ExprCode[ExprCodeUsed + 3] = (BYTE)(Addr & 0xFF);
+
+    ExprIdxAddr[ExprRecSlot] = ExprRecAddr;
+    ExprIdxCode[ExprRecSlot] = (WORD)(ExprCodeUsed + 1);
+    ExprCodeUsed = ExprRecPtr;
+}
+
+
+// Evaluate a compiled expression.  Code is the offset returned by
+// StartExprCode().  Leaves the stream and stacks just as Expression()
+// would and returns the token that stopped the expression.
+
+BYTE RunExprCode(WORD Code)
+{
+    BYTE *pc;
+    BYTE Token;
+    WORD Addr;
+
+    InitStacks();
+    pc = &ExprCode[Code + 3];   // skip the header
+
+    while (SyntaxErrorCode == ERROR_NONE)
+    {
+        Token = pc[1];
+        Addr = (WORD)((pc[2] << 8) | pc[3]);
+
+        switch (pc[0])
+        {
+            case EXPR_CONST:
+                Read2uData2(Token, Addr);
+                PushStk(CALC_STACK, Token);
+                break;
+
+            case EXPR_VAR:
+                SetStream51(Addr);
+                if (GetSimpleVar())    // Read variable into uData
+                {
+                    SyntaxErrorCode = ERROR_UNDEFINED_VARIABLE;
+                    break;
+                }
+                if (Token == TOKEN_NOTYPE_VAR)
+                    Token += (BYTE) uHash.str.TypeFlag;
+                PushStk(CALC_STACK, (BYTE)(Token - 4));  // convert to constant
+                break;
+
+            case EXPR_LETVAR:
+                SetStream51(Addr);
+                uData.sVal.sPtr = GetProgVarPtr(VARPTR_ASSIGN_SIMPLE);
+                if (Token == TOKEN_NOTYPE_VAR)
+                    Token += (BYTE) uHash.str.TypeFlag;
+                PushStk(CALC_STACK, Token);
+                break;
+
+            case EXPR_ARRAY:
+                SetStream51(Addr);
+                uData.sVal.sPtr = GetProgVarPtr(VARPTR_ARRAY);
+                if (!uData.sVal.sPtr)
+                {
+                    SyntaxErrorCode = ERROR_UNDEFINED_VARIABLE;
+                    break;
+                }
+                PushStk(OPERATOR_STACK, uData.bVal[0]);
+                PushStk(OPERATOR_STACK, uData.bVal[1]);
+                if (Token == TOKEN_NOTYPE_ARRAY)
+                    Token += (BYTE) uHash.str.TypeFlag;
+                PushStk(OPERATOR_STACK, Token);
+                break;
+
+            case EXPR_ELEMENT:
+            case EXPR_ARRAYVAL:
+                Addr = PopStk(OPERATOR_STACK);    // array type
+                uData.bVal[1] = PopStk(OPERATOR_STACK);
+                uData.bVal[0] = PopStk(OPERATOR_STACK);
+                if (pc[0] == EXPR_ELEMENT) PushElementPtr((BYTE) Addr, Token);
+                else EvaluateArray((BYTE) Addr, Token);
+                break;
+
+            case EXPR_FUNC:
+                EvaluateFunction(Token, (BYTE) Addr);
+                break;
+
+            case EXPR_OP:
+                Evaluate(Token);
+                break;
+
+            default:    // EXPR_END
+                goto Done;
+        }
+
+        pc += 4;
+    }
+
+Done:
+    // Continue after the token that stopped the expression
+    SetStream51((WORD)((ExprCode[Code + 1] << 8) | ExprCode[Code + 2]));
+
+    return(ExprCode[Code]);
+}
+
+
+#ifdef BAS51_VM
+
+// TYPED EXPRESSIONS
+// The statement VM in command.c runs expressions from a second form of the
+// compiled code above.  Constants are copied in, simple variables are
+// resolved to the address of their value and the type of every value is
+// worked out in advance, so the VM just pushes and pops values and each
+// operator goes straight to the INTL or float half of NumericOp().  Only
+// numeric expressions made of constants, simple variables and operators
+// are translated, anything with a string, an array or a function is left to
+// RunExprCode().  The variable addresses are only good until VarGeneration
+// changes, the VM translates the statement again after that.
+
+#ifndef TYPED_CODE_SIZE
+#define TYPED_CODE_SIZE   8192
+#endif
+
+#define TYPED_CODE_MIN    512     // room needed to decode a statement
+#define TYPED_STACK_SIZE  16
+
+// Ops are one byte.  CONST is followed by the value, VAR and STORE by the
+// address of the variable, INTL_OP and FLOAT_OP by the operator token.
+enum { TYPED_END, TYPED_CONST, TYPED_VAR, TYPED_FLOAT, TYPED_FLOAT2,
+       TYPED_INTL, TYPED_INTL_OP, TYPED_FLOAT_OP, TYPED_STORE };
+
+XDATA BYTE TypedCode[TYPED_CODE_SIZE];
+WORD TypedCodeUsed;
+UVAL_DATA TypedStack[TYPED_STACK_SIZE];
+
+
+// Throw away all typed code.  Called by ClearVMCache().
+
+void ClearTypedCode(void)
+{
+    TypedCodeUsed = 0;
+}
+
+
+// Return TRUE if there may not be room to decode another statement.
+
+BIT TypedCodeFull(void)
+{
+    return((BIT)(TypedCodeUsed > TYPED_CODE_SIZE - TYPED_CODE_MIN));
+}
+
+
+static void TypedEmitWord(BYTE Op, WORD w)
+{
+    TypedCode[TypedCodeUsed++] = Op;
+    TypedCode[TypedCodeUsed++] = (BYTE)(w >> 8);
+    TypedCode[TypedCodeUsed++] = (BYTE)(w & 0xFF);
+}
+
+
+// Translate the expression at Addr, compiled with Flags, into typed code.
+// If Type is TOKEN_INTL_CONST or TOKEN_FLOAT_CONST the value is converted
+// to it, the way FOR does.  An assignment leaves no value.  Returns the
+// offset of the typed code + 1, or 0 if it can't be translated or has not
+// been compiled yet.  The token that stopped the expression and the stream
+// address after it are returned in *Stop and *End.  Moves the stream.
+
+WORD TypeExprCode(WORD Addr, BYTE Flags, BYTE Type, BYTE *Stop, WORD *End)
+{
+    BYTE Types[TYPED_STACK_SIZE];   // Type of each value on the stack
+    BYTE *pc;
+    BYTE Depth, Token, LetType, b;
+    WORD Code, Start, Ptr, LetPtr;
+    BIT Assigned;
+
+    Code = ExprIdxCode[EXPR_SLOT(Addr)];
+    if (!Code || ExprIdxAddr[EXPR_SLOT(Addr)] != Addr ||
+        ExprCode[Code - 1] != Flags)
+        return(0);
+
+    *Stop = ExprCode[Code];
+    *End = (WORD)((ExprCode[Code + 1] << 8) | ExprCode[Code + 2]);
+
+    Start = TypedCodeUsed;
+    Depth = 0;
+    LetType = 0;
+    LetPtr = 0;
+    Assigned = FALSE;
+
+    for (pc = &ExprCode[Code + 3]; pc[0] != EXPR_END; pc += 4)
+    {
+        if (TypedCodeUsed > TYPED_CODE_SIZE - 16) goto Fail;   // out of room
+
+        Token = pc[1];
+        Ptr = (WORD)((pc[2] << 8) | pc[3]);
+
+        switch (pc[0])
+        {
+            case EXPR_CONST:
+                if (Token != TOKEN_INTL_CONST && Token != TOKEN_FLOAT_CONST)
+                    goto Fail;
+                if (Depth == TYPED_STACK_SIZE) goto Fail;
+                Read2uData2(Token, Ptr);
+                TypedCode[TypedCodeUsed++] = TYPED_CONST;
+                for (b = 0; b != sizeof(UVAL_DATA); b++)
+                    TypedCode[TypedCodeUsed++] = uData.bVal[b];
+                Types[Depth++] = Token;
+                break;
+
+            case EXPR_VAR:
+            case EXPR_LETVAR:
+                SetStream51(Ptr);
+                Ptr = GetProgVarPtr((BYTE)(pc[0] == EXPR_VAR ?
+                    VARPTR_READ_SIMPLE : VARPTR_ASSIGN_SIMPLE));
+                if (!Ptr) goto Fail;    // undefined, let RunExprCode() say so
+                if (Token == TOKEN_NOTYPE_VAR)
+                    Token += (BYTE) uHash.str.TypeFlag;
+                if (Token != TOKEN_INTL_VAR && Token != TOKEN_FLOAT_VAR)
+                    goto Fail;
+
+                if (pc[0] == EXPR_LETVAR)
+                {
+                    if (Depth || LetPtr) goto Fail;
+                    LetPtr = Ptr;
+                    LetType = (BYTE)(Token - 4);
+                    break;
+                }
+
+                if (Depth == TYPED_STACK_SIZE) goto Fail;
+                TypedEmitWord(TYPED_VAR, Ptr);
+                Types[Depth++] = (BYTE)(Token - 4);
+                break;
+
+            case EXPR_OP:
+                if (Token == TOKEN_ASSIGN)
+                {
+                    if (!LetPtr || Assigned || Depth != 1) goto Fail;
+                    if (Types[0] != LetType)    // convert like Evaluate()
+                        TypedCode[TypedCodeUsed++] = (BYTE)
+                            (LetType == TOKEN_INTL_CONST ? TYPED_INTL : TYPED_FLOAT);
+                    TypedEmitWord(TYPED_STORE, LetPtr);
+                    Depth = 0;
+                    Assigned = TRUE;
+                    break;
+                }
+
+                if (Token != TOKEN_NOT && Token != TOKEN_UNARY_MINUS)
+                {
+                    if (Depth < 2) goto Fail;
+                    Depth--;
+                    if (Types[Depth] != Types[Depth - 1])  // INTL one to float
+                    {
+                        TypedCode[TypedCodeUsed++] = (BYTE)
+                            (Types[Depth] == TOKEN_INTL_CONST ? TYPED_FLOAT : TYPED_FLOAT2);
+                        Types[Depth - 1] = TOKEN_FLOAT_CONST;
+                    }
+                }
+                else if (Depth < 1) goto Fail;
+
+                TypedCode[TypedCodeUsed++] = (BYTE)
+                    (Types[Depth - 1] == TOKEN_FLOAT_CONST ? TYPED_FLOAT_OP : TYPED_INTL_OP);
+                TypedCode[TypedCodeUsed++] = Token;
+                break;
+
+            default:    // arrays and functions
+                goto Fail;
+        }
+    }
+
+    if (LetPtr)
+    {
+        if (!Assigned || Depth != 0) goto Fail;
+    }
+    else
+    {
+        if (Depth != 1) goto Fail;
+        if ((Type == TOKEN_INTL_CONST || Type == TOKEN_FLOAT_CONST) &&
+            Types[0] != Type)
+            TypedCode[TypedCodeUsed++] = (BYTE)
+                (Type == TOKEN_INTL_CONST ? TYPED_INTL : TYPED_FLOAT);
+    }
+
+    TypedCode[TypedCodeUsed++] = TYPED_END;
+    return((WORD)(Start + 1));
+
+Fail:
+    TypedCodeUsed = Start;
+    SyntaxErrorCode = ERROR_NONE;   // the token interpreter will report it
+    return(0);
+}
+
+
+// Run typed code.  Code is the offset returned by TypeExprCode().  The
+// value, if there is one, is left in uData.  Returns TRUE on error.
+
+BIT RunTypedCode(WORD Code)
+{
+    BYTE *pc;
+    UVAL_DATA *sp;   // next free entry on the stack
+    BYTE Op, b;
+
+    pc = &TypedCode[Code - 1];
+    sp = TypedStack;
+
+    while (1)
+    {
+        switch (Op = *pc++)
+        {
+            case TYPED_CONST:
+                for (b = 0; b != sizeof(UVAL_DATA); b++) sp->bVal[b] = *pc++;
+                sp++;
+                break;
+
+            case TYPED_VAR:
+                ReadBlock51((BYTE *) sp++, (WORD)((pc[0] << 8) | pc[1]),
+                    sizeof(UVAL_DATA));
+                pc += 2;
+                break;
+
+            case TYPED_FLOAT:
+                sp[-1].fVal = sp[-1].LVal;
+                break;
+
+            case TYPED_FLOAT2:
+                sp[-2].fVal = sp[-2].LVal;
+                break;
+
+            case TYPED_INTL:
+                sp[-1].LVal = sp[-1].fVal;
+                break;
+
+            case TYPED_INTL_OP:
+            case TYPED_FLOAT_OP:
+                uValArg[1] = *--sp;
+                if (*pc != TOKEN_NOT && *pc != TOKEN_UNARY_MINUS)
+                    uValArg[0] = *--sp;
+                if (NumericOp(*pc++, (BIT)(Op == TYPED_FLOAT_OP))) return(TRUE);
+                *sp++ = uData;
+                break;
+
+            case TYPED_STORE:
+                COST51(COST51_INT_OP);
+                WriteBlock51((WORD)((pc[0] << 8) | pc[1]), (BYTE *) --sp,
+                    sizeof(UVAL_DATA));
+                pc += 2;
+                break;
+
+            default:    // TYPED_END
+                if (sp != TypedStack) uData = sp[-1];
+                return(FALSE);
+        }
+    }
+}
+
+#endif
+
+#else
+
+#define ExprEmit(Op, Arg, Addr)
+
+void ClearExprCache(void)
+{
+}
+
+#endif
+
 // Parse an expression in memory
 // Uses ReadStream51() to get the next char to evaluate.
 // Assignment is TRUE if this is part of a LET statement.
@@ -114,6 +600,14 @@ BYTE Expression(BYTE Flags)
 //    Len, b, A,
 
     Parenthesis = 0;
+#ifdef EXPR_COMPILE
+    {
+        WORD Code;
+
+        Code = StartExprCode(Flags);
+        if (Code) return(RunExprCode(Code));
+    }
+#endif
     InitStacks();
 
     Token = ReadStream51();
@@ -128,6 +622,7 @@ BYTE Expression(BYTE Flags)
             BYTE B, Len;
 
             // Read into uData and push
+            ExprEmit(EXPR_CONST, Token, GetStreamAddr());
             Len = Read2uData2(Token, GetStreamAddr());
             for (B = 0; B != Len; B++) ReadStream51();  // keep in sync
 			PushStk(CALC_STACK, Token);
@@ -150,6 +645,7 @@ BYTE Expression(BYTE Flags)
             {
                 // ASSIGN a simple variable
             	// Get address of variable and push it to calc stack
+                ExprEmit(EXPR_LETVAR, Token, GetStreamAddr());
                 uData.sVal.sPtr = GetProgVarPtr(VARPTR_ASSIGN_SIMPLE);
 
                 // Correct for untyped variables
@@ -173,6 +669,7 @@ BYTE Expression(BYTE Flags)
             else  // Read Var and Convert into constant
             {
             	// Read into uData and push
+                ExprEmit(EXPR_VAR, Token, GetStreamAddr());
             	if (GetSimpleVar())    // Read variable into uData
             	{
 					SyntaxErrorCode = ERROR_UNDEFINED_VARIABLE;
@@ -214,6 +711,7 @@ BYTE Expression(BYTE Flags)
             else // not declaring array
             {
 	            // Get the base address of array and push it to operator stack
+                ExprEmit(EXPR_ARRAY, Token, GetStreamAddr());
     	        uData.sVal.sPtr = GetProgVarPtr(VARPTR_ARRAY);
         	    if (!uData.sVal.sPtr)
             	{
@@ -255,6 +753,7 @@ BYTE Expression(BYTE Flags)
             {
                 // There are no parameters or parenthesis so evaluate now
                 // Convert to a constant
+                ExprEmit(EXPR_FUNC, Token, 0);
                 EvaluateFunction(Token, 0);
             }
             else   // this is a regular function
@@ -293,6 +792,7 @@ BYTE Expression(BYTE Flags)
 					SyntaxErrorCode = ERROR_PARAMETER;
 					return(Token);
 				}
+                ExprEmit(EXPR_OP, Op, 0);
 				Evaluate(Op);
 			}  // end while()
 
@@ -345,7 +845,9 @@ BYTE Expression(BYTE Flags)
 					if (Precedence(Token) > Precedence(LastToken)) break;
 				}
 
-                Evaluate(PopStk(OPERATOR_STACK));  // Evaluate based on operator
+                LastToken = PopStk(OPERATOR_STACK);
+                ExprEmit(EXPR_OP, LastToken, 0);
+                Evaluate(LastToken);  // Evaluate based on operator
 
 				LastToken = PeekStk(OPERATOR_STACK);
 			}
@@ -377,6 +879,7 @@ BYTE Expression(BYTE Flags)
 					return(Token);
 				}
 
+                ExprEmit(EXPR_OP, Op, 0);
                 Evaluate(Op);
 
 			}  // end while()
@@ -401,7 +904,9 @@ BYTE Expression(BYTE Flags)
 					SyntaxErrorCode = ERROR_PARAMETER;
 					return(Token);
             	}
-                EvaluateFunction(PopStk(OPERATOR_STACK), ArgCnt);
+                LastToken = PopStk(OPERATOR_STACK);
+                ExprEmit(EXPR_FUNC, LastToken, ArgCnt);
+                EvaluateFunction(LastToken, ArgCnt);
 			}
 
             // Check to see if this was the closing paren for an array
@@ -450,12 +955,14 @@ BYTE Expression(BYTE Flags)
                 	if (Flags & EXPRESSION_ASSIGNMENT_FLAG)
 	                {
     	                // Get pointer to element and push that to calc stack
+                        ExprEmit(EXPR_ELEMENT, ArgCnt, 0);
         	            PushElementPtr(ArrayType, ArgCnt);
             	        Flags &= ~EXPRESSION_ASSIGNMENT_FLAG;
                 	}
 		            else
         	        {
             	        // Get array value and push on calc stack
+                        ExprEmit(EXPR_ARRAYVAL, ArgCnt, 0);
                     	EvaluateArray(ArrayType, ArgCnt);
                 	}
                 } // else not dim
@@ -492,9 +999,14 @@ BYTE Expression(BYTE Flags)
 	        SyntaxErrorCode = ERROR_PARENTHESIS_MISMATCH;
 	        return(Token);
 	    }
+        ExprEmit(EXPR_OP, Op, 0);
 		Evaluate(Op);
 	}
 
+#ifdef EXPR_COMPILE
+    EndExprCode(Token);
+#endif
+
     /*
     if (!StackEmpty(CALC_STACK))   // Calc stack
     {
@@ -0,0 +1,66 @@
+/*
+This source file is part of the TRS-8051 project.  BAS51 is a work alike
+rewrite of the Microsoft Level 2 BASIC for the TRS-80 that is intended to run
+on an 8051 microprocessor.  This version is in intended to also run under
+Windows for testing purposes.
+
+Copyright (C) 2017  Dennis Hawkins
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+If you use this code in any way, I would love to hear from you.  My email
+address is: dennis@galliform.com
+*/
+
+/*
+EXT_TOKENS.H - Tokens for the statements added after the token numbers from
+128 up were all used.  They are numbered from EXT_TOKEN_START, which is
+below the printable characters and can never be confused with the '\r'
+that ends a line.  Their names are in ExtTokenTable[] in globals.c.
+*/
+
+#ifndef EXT_TOKENS_H
+#define EXT_TOKENS_H
+
+#define EXT_TOKEN_START  0x10
+
+enum
+{
+    TOKEN_SNAPSHOT = EXT_TOKEN_START,
+    TOKEN_PROFILE,
+    TOKEN_STATS,
+    TOKEN_ENDIF,
+    TOKEN_WHILE,
+    TOKEN_WEND,
+    TOKEN_DO,
+    TOKEN_LOOP,
+    TOKEN_UNTIL,
+    TOKEN_LOOP_WHILE,  // WHILE after LOOP, set by the tokenizer
+    TOKEN_SELECT,
+    TOKEN_CASE,
+    LAST_EXT_TOKEN     // must stay below 0x20
+};
+
+// A block ELSE, one that starts a statement on a line with no single line
+// IF ahead of it, has this in the offset byte that follows every ELSE.
+// BEGIN and a block ELSE are both followed by a 4 byte link, see BLOCK IF
+// in flow_cmds.c.  A WHILE that starts a statement and every CASE are
+// followed by a 4 byte link too, see SELECT CASE in flow_cmds.c.
+
+#define BLOCK_ELSE   0xFF
+
+extern CODE BYTE ExtTokenTable[];
+
+#endif
@@ -29,6 +29,18 @@ FLOW_CMDS.C - Various routines to handle the flow between BASIC statements.
 */
 
 #include "bas51.h"
+#include "ext_tokens.h"
+
+void PopFor(void);          // stacks.c
+BIT GetLoop(BYTE Token);    // stacks.c
+void PopLoop(void);         // stacks.c
+BIT PushForLoop(void);
+
+// Loop kinds, chosen by FOR so that NEXT runs the simplest test that will do
+enum { FOR_INT_INC, FOR_INT_UP, FOR_INT_DOWN, FOR_FLOAT_UP, FOR_FLOAT_DOWN };
+
+BYTE gForKind;              // Kind of the loop in gFor
+WORD gForTop;               // GosubStackTop when gFor was pushed or fetched
 
 
 // Get the return address for the next statement.
@@ -95,6 +107,123 @@ void GotoHelper(BIT GosubFlag)
 }
 
 
+// LINKED LINE NUMBERS
+// A line number constant after GOTO, GOSUB, THEN, ELSE, ON and RESUME is
+// looked up the first time it is executed, and the address of the line is
+// then stored in the upper 16 bits of the constant itself.  The lower 16
+// bits stay the line number, so anything that reads the value as a WORD
+// still sees the line.  Every linked constant is remembered in LinkTable[]
+// so that UnlinkProgram() can put them all back before the program is
+// edited, renumbered or listed.  When the table is full, jumps just go back
+// to looking the line up every time.  A constant that was typed in above
+// 65535 has upper bits too, so the upper bits only count as a link if they
+// point into the program just after the header of a line.  That is the
+// line in the lower bits, or the one after it when there is no such line
+// and the jump falls through.  Anything else gets the range check and
+// INVALID LINE NUMBER.
+
+#ifdef __C51__
+#define LINK_TABLE_SIZE   32
+#else
+#define LINK_TABLE_SIZE   1024
+#endif
+
+XDATA WORD LinkTable[LINK_TABLE_SIZE];    // Addresses of linked constants
+WORD LinkCount;
+BYTE CaseTables;     // SELECT CASE jump tables in use, see SELECT CASE
+WORD CaseEntries;    // and entries
+
+
+// Return TRUE if the constant at ConstAddr can be linked, because it is
+// part of the program and there is room to remember it.
+
+static BIT CanLink(WORD ConstAddr)
+{
+    return((BIT)(ConstAddr >= BasicVars.ProgStart &&
+        ConstAddr < BasicVars.VarStart &&  // never link the command line
+        LinkCount != LINK_TABLE_SIZE));
+}
+
+
+// Link the constant at ConstAddr to Addr, the address to jump to for Line,
+// if it can be and it isn't linked already.
+
+static void LinkConst(WORD ConstAddr, WORD Addr, WORD Line)
+{
+    if (CanLink(ConstAddr) && ((DWORD) ReadRandomLong(ConstAddr) >> 16) == 0)
+    {
+        LinkTable[LinkCount++] = ConstAddr;
+        WriteRandomLong(ConstAddr, (long)(((DWORD) Addr << 16) | Line));
+    }
+}
+
+
+// Forget every link without touching the program, for when there is no
+// program or it was replaced.  The SELECT CASE jump tables go with the
+// links to them.
+
+void ForgetLinks(void)
+{
+    LinkCount = 0;
+    CaseTables = 0;
+    CaseEntries = 0;
+}
+
+
+// Restore every linked line number constant to a plain line number.
+
+void UnlinkProgram(void)
+{
+    WORD addr;
+
+    while (LinkCount)
+    {
+        addr = LinkTable[--LinkCount];
+        WriteRandomLong(addr, (long)(WORD) ReadRandomLong(addr));
+    }
+    ForgetLinks();
+}
+
+
+// uData holds a line number constant read from address ConstAddr.
+// Convert it to the form GotoHelper() wants, the target address in
+// uData.wVal[0] and the line number in uData.wVal[1].  If the constant
+// hasn't been linked yet, look the line up and link it.
+// Return TRUE on error.
+
+BIT ResolveLineConst(WORD ConstAddr)
+{
+    WORD Line, Addr;
+
+    Line = (WORD) uData.LVal;
+    Addr = (WORD)((DWORD) uData.LVal >> 16);
+
+    // Make sure a link is not just a big line number
+    if (Addr != 0 &&
+        (Addr < BasicVars.ProgStart + 3 || Addr >= BasicVars.VarStart ||
+         ReadRandomWord((WORD)(Addr - 3)) < Line))
+        Addr = 0;
+
+    if (Addr == 0)   // not linked yet
+    {
+        if (uData.LVal <= 0 || uData.LVal > MAX_LINE_NUMBER)
+        {
+            SyntaxErrorCode = ERROR_INVALID_LINE_NUMBER;
+            return(TRUE);
+        }
+
+        Addr = FindLinePtr(Line, FALSE);
+        if (Addr) LinkConst(ConstAddr, (WORD)(Addr + 3), Line);
+        Addr += (WORD) 3;   // skip line number and length
+    }
+
+    uData.wVal[0] = Addr;
+    uData.wVal[1] = Line;
+
+    return(FALSE);
+}
+
+
 // Read Goto Line number and jump to new line
 // If GosubFlag is TRUE, then the return address is also
 // pushed to the FOR_GOSUB stack.
@@ -103,6 +232,25 @@ void GotoHelper(BIT GosubFlag)
 BIT DoGotoCmd(BIT GosubFlag)
 {
     BYTE Token;
+    WORD ConstAddr;
+
+    // Plain line number constant, skip the expression parser
+    if (PeekStream51() == TOKEN_INTL_CONST)
+    {
+        ReadStream51();
+        ConstAddr = GetStreamAddr();
+        uData.LVal = ReadStreamLong();
+        CurChar = ReadStream51();
+        if (TerminalChar())
+        {
+            if (ResolveLineConst(ConstAddr)) return(TRUE);
+            GotoHelper(GosubFlag);
+            return(FALSE);
+        }
+
+        // Part of an expression after all, start over
+        SetStream51((WORD)(ConstAddr - 1));
+    }
 
     Token = GetSimpleExpr();    // Get the line number
     // Line number now in uData
@@ -156,6 +304,19 @@ BIT ForHelper(BYTE ExpectedToken)
 
 }
 
+// Pick the loop kind for a FOR descriptor.  A STEP of zero counts down,
+// as it always has.
+
+BYTE ForKind(FOR_DESCRIPTOR *f)
+{
+    if (f->VarType == TOKEN_FLOAT_VAR)
+        return((BYTE)(f->StepField.fVal > 0 ? FOR_FLOAT_UP : FOR_FLOAT_DOWN));
+
+    if (f->StepField.LVal == 1) return(FOR_INT_INC);
+    return((BYTE)(f->StepField.LVal > 0 ? FOR_INT_UP : FOR_INT_DOWN));
+}
+
+
 // FOR Statement
 // Create FOR_DESCRIPTOR global and push to FOR_GOSUB stack
 
@@ -199,12 +360,25 @@ BIT DoForCmd(void)
 
     if (!TerminalChar()) return(TRUE);   // illegal junk on line
 
+    return(PushForLoop());
+}
+
+
+// Push the loop in gFor, which has everything but where to go back to.
+// The stream is after the end of the FOR statement.  Also used by the
+// statement VM.
+
+BIT PushForLoop(void)
+{
     // Save current address in LoopCmdAddr
     GetReturnAddress();
     gFor.LoopCmdAddr = gReturn.ReturnPtr;
     gFor.Line = gReturn.Line;
+    gForKind = ForKind(&gFor);
 
-    return(PushStruct(TOKEN_FOR)); // Push to FOR_GOSUB stack
+    if (PushStruct(TOKEN_FOR)) return(TRUE); // Push to FOR_GOSUB stack
+    gForTop = BasicVars.GosubStackTop;
+    return(FALSE);
 }
 
 // Next Helper function
@@ -215,52 +389,55 @@ BIT NextHelper(void)
 {
     BIT Jump;
 
-    // read variable
+    // read variable, the loop body may have changed it
   	ReadBlock51((BYTE *) &uData, gFor.CtrlVarPtr, sizeof(UVAL_DATA));
 
-    Jump = FALSE;
-    if (gFor.VarType == TOKEN_FLOAT_VAR)
+    // increment control variable and test it the way FOR picked
+    switch (gForKind)
     {
-        uData.fVal += gFor.StepField.fVal;   // increment control variable
-
-        if (gFor.StepField.fVal > 0)  // positive test - 1 TO 100
-		{
-         	if (uData.fVal <= gFor.ToField.fVal) Jump = TRUE;
-        }
-        else   // negative test - 100 TO 1 STEP -1
-        {
-         	if (uData.fVal >= gFor.ToField.fVal) Jump = TRUE;
-        }
-    }
-    else    // INTL version
-    {
-        uData.LVal += gFor.StepField.LVal;   // increment control variable
-
-        if (gFor.StepField.LVal > 0)  // positive test - 1 TO 100
-		{
-         	if (uData.LVal <= gFor.ToField.LVal) Jump = TRUE;
-        }
-        else   // negative test - 100 TO 1 STEP -1
-        {
-         	if (uData.LVal >= gFor.ToField.LVal) Jump = TRUE;
-        }
+        case FOR_INT_INC:     // FOR I%=1 TO 100
+            Jump = (BIT)(++uData.LVal <= gFor.ToField.LVal);
+            break;
+
+        case FOR_INT_UP:      // FOR I%=1 TO 100 STEP 5
+            uData.LVal += gFor.StepField.LVal;
+            Jump = (BIT)(uData.LVal <= gFor.ToField.LVal);
+            break;
+
+        case FOR_INT_DOWN:    // FOR I%=100 TO 1 STEP -1
+            uData.LVal += gFor.StepField.LVal;
+            Jump = (BIT)(uData.LVal >= gFor.ToField.LVal);
+            break;
+
+        case FOR_FLOAT_UP:
+            uData.fVal += gFor.StepField.fVal;
+            Jump = (BIT)(uData.fVal <= gFor.ToField.fVal);
+            break;
+
+        default:              // FOR_FLOAT_DOWN
+            uData.fVal += gFor.StepField.fVal;
+            Jump = (BIT)(uData.fVal >= gFor.ToField.fVal);
+            break;
     }
 
     // Write updated variable
   	WriteBlock51(gFor.CtrlVarPtr, (BYTE *) &uData, sizeof(UVAL_DATA));
 
-    // Jump back
+    // Jump back.  The address came from FOR, so GotoHelper() is not needed.
     if (Jump)
     {
-    	uData.wVal[0] = gFor.LoopCmdAddr;
-        uData.wVal[1] = gFor.Line;
-        GotoHelper(FALSE);
+        if (gFor.LoopCmdAddr)
+        {
+            SetStream51(gFor.LoopCmdAddr);
+            CurChar = TOKEN_COLON;
+            LineNo = gFor.Line;
+        }
+        else Running = FALSE;    // FOR was last on the command line
     }
     else
     {
         gFor.CtrlVarPtr = 0;   // mark as invalid, jump not taken
-        // chop stack
-        BasicVars.GosubStackTop -= (WORD)(sizeof(FOR_DESCRIPTOR) + 1);
+        PopFor();              // chop stack
     }
 
     return(Jump);
@@ -268,15 +445,37 @@ BIT NextHelper(void)
 
 // NEXT STATEMENT
 
+// Get the FOR descriptor for NEXT into gFor.  Most of the time the loop
+// is still on top of the stack from the last FOR or NEXT and gFor already
+// holds it, so the stack search can be skipped.
+
+static BIT FindNextFor(void)
+{
+    if (gFor.CtrlVarPtr && gForTop == BasicVars.GosubStackTop &&
+        (uHash.d == 0 || uHash.d == gFor.Hash.d) &&
+        ReadRandom51((WORD)(gForTop - 1)) == TOKEN_FOR) return(FALSE);
+
+    return(GetFor());
+}
+
+
+// NEXT for the loop of the variable with hash Hash, or the innermost loop
+// if Hash is 0.  The stream is after the end of the NEXT statement.  Also
+// used by the statement VM.
+
+BIT NextLoop(DWORD Hash)
+{
+    uHash.d = Hash;
+    if (FindNextFor()) return(TRUE);
+    NextHelper();
+    return(FALSE);
+}
+
+
 BIT DoNextCmd(void)
 {
     if (GetTerminalToken())   // no parameters
-    {
-        uHash.d = 0;     // find first available FOR structure
-        if (GetFor()) return(TRUE);
-        NextHelper();
-        return(FALSE);
-    }
+        return(NextLoop(0));     // find first available FOR structure
 
     // We have parameters if here
     while (1)
@@ -288,7 +487,7 @@ BIT DoNextCmd(void)
         if (uHash.str.TypeFlag == 3) return(TRUE);  // stringa not allowed
 
         // Get FOR structure
-        if (GetFor()) return(TRUE);   // Error if FOR variable not found
+        if (FindNextFor()) return(TRUE);   // Error if FOR variable not found
 
         // process FOR-NEXT
         if (NextHelper()) break;   // Jump taken, process no more variables
@@ -366,8 +565,9 @@ BIT DoOnCmd(void)
             if (JumpPos == 0)
             {
                 // Store line data in gReturn because we can't jump right now
-                gReturn.Line = (WORD) uData.LVal;
-                gReturn.ReturnPtr = (WORD)(FindLinePtr(gReturn.Line, FALSE) + 3);  // Get Line address
+                if (ResolveLineConst(uHash.ptr)) return(TRUE);
+                gReturn.Line = uData.wVal[1];
+                gReturn.ReturnPtr = uData.wVal[0];  // Get Line address
             }
 
             CurChar = ReadStream51();
@@ -418,8 +618,7 @@ BIT DoResumeCmd(void)
     }
     else if (CurChar == TOKEN_INTL_CONST)  // Line number - resume to line#
     {
-        uData.wVal[1] = (WORD) uData.LVal;
-	    uData.wVal[0] = (WORD)(FindLinePtr(uData.wVal[1], FALSE) + 3);  // Get Line address
+        if (ResolveLineConst(uHash.ptr)) return(TRUE);
     }
     else
     {
@@ -436,13 +635,176 @@ BIT DoResumeCmd(void)
 
 
 
+// BLOCK IF
+// IF <expression> BEGIN runs the statements up to the matching ELSE or
+// ENDIF when the expression is true, and the ones between the ELSE and the
+// ENDIF when it is false.  Blocks may span lines and be nested.  BEGIN and
+// a block ELSE are followed by a 4 byte link that is filled in the first
+// time their jump is taken, the same way as a linked line number constant:
+// the address to continue at in the upper 16 bits and its line number in
+// the lower 16.  The links go in LinkTable[] too, so UnlinkProgram() clears
+// them when lines move and the next jump scans for the target again.
+// A WHILE that is false from the start jumps past its WEND the same way,
+// and so does a CASE at the end of the statements of the case before it.
+
+
+// Scan forward from the stream for the next CASE or END SELECT of the
+// SELECT CASE that is being run, skipping any nested in it.  Return
+// TOKEN_CASE with the stream after its link, TOKEN_END with the stream
+// after END SELECT, or 0 if the program ends first.  LineNo follows the
+// scan.
+
+static BYTE NextCase(void)
+{
+    BYTE Token, Depth;
+
+    Depth = 0;
+    while (1)
+    {
+        Token = GetNextToken();
+        if (Token == TOKEN_REM || Token == TOKEN_REM2)
+            while ((Token = ReadStream51()) != '\r');
+
+        if (Token == '\r')
+        {
+            if (GetStreamAddr() >= BasicVars.VarStart - 1) return(0);
+            LineNo = ReadStreamWord();   // line number
+            ReadStream51();              // length
+        }
+        else if (Token == TOKEN_SELECT) Depth++;
+        else if (Token == TOKEN_END && PeekStream51() == TOKEN_SELECT)
+        {
+            ReadStream51();
+            if (Depth == 0) return(TOKEN_END);
+            Depth--;
+        }
+        else if (Token == TOKEN_CASE && Depth == 0) return(TOKEN_CASE);
+    }
+}
+
+
+// Scan forward from the stream for the end of the block opened by Open.
+// That is the ENDIF for a block ELSE, the ELSE or ENDIF for BEGIN, the
+// WEND for WHILE and the END SELECT for CASE.  Nested blocks are skipped.
+// The stream is left after the token found, and its line number is returned
+// in uData.wVal[1].
+// Return TRUE if the program ends first.
+
+static BIT FindBlockEnd(BYTE Open)
+{
+    BYTE Token, Depth, Nest, Close;
+    WORD Line;
+
+    if (Open == TOKEN_CASE)
+    {
+        Line = LineNo;
+        while ((Token = NextCase()) == TOKEN_CASE);
+        uData.wVal[1] = LineNo;
+        LineNo = Line;
+        return((BIT)(Token == 0));
+    }
+
+    Nest = TOKEN_BEGIN;
+    Close = TOKEN_ENDIF;
+    if (Open == TOKEN_WHILE)
+    {
+        Nest = TOKEN_WHILE;
+        Close = TOKEN_WEND;
+    }
+
+    Line = LineNo;
+    Depth = 0;
+    while (1)
+    {
+        Token = GetNextToken();
+        if (Token == TOKEN_REM || Token == TOKEN_REM2)
+            while ((Token = ReadStream51()) != '\r');
+
+        if (Token == '\r')
+        {
+            if (GetStreamAddr() >= BasicVars.VarStart - 1) return(TRUE);
+            Line = ReadStreamWord();   // line number
+            ReadStream51();            // length
+        }
+        else if (Token == Nest) Depth++;
+        else if (Token == Close)
+        {
+            if (Depth == 0) break;
+            Depth--;
+        }
+        else if (Token == TOKEN_ELSE && uData.bVal[0] == BLOCK_ELSE &&
+                 Depth == 0 && Open == TOKEN_BEGIN) break;
+    }
+
+    uData.wVal[1] = Line;
+    return(FALSE);
+}
+
+
+// Take the jump of the BEGIN, block ELSE, WHILE or CASE in Open whose link
+// is at the stream address.  See FindBlockEnd() for where each one goes.
+// Return TRUE on error.
+
+static BIT BlockJump(BYTE Open)
+{
+    WORD LinkAddr, Line, Addr;
+
+    LinkAddr = GetStreamAddr();
+    uData.LVal = ReadStreamLong();
+    Line = (WORD) uData.LVal;
+    Addr = (WORD)((DWORD) uData.LVal >> 16);
+
+    if (Addr == 0)   // not linked yet
+    {
+        if (FindBlockEnd(Open))
+        {
+            SyntaxErrorCode = ERROR_SYNTAX;   // no ENDIF, WEND or END SELECT
+            return(TRUE);
+        }
+        Addr = GetStreamAddr();
+        Line = uData.wVal[1];
+        LinkConst(LinkAddr, Addr, Line);
+    }
+
+    uData.wVal[0] = Addr;
+    uData.wVal[1] = Line;
+    GotoHelper(FALSE);
+
+    return(FALSE);
+}
+
+
+// ELSE at the start of a statement.  A block ELSE is reached at the end of
+// the true part of its block and jumps past the ENDIF.  Any other ELSE ends
+// the clause of a single line IF, the same as in TerminalChar().
+
+BIT DoElseCmd(void)
+{
+    if (PeekStream51() != BLOCK_ELSE)
+    {
+        TerminalChar();    // skip to the end of the line
+        return(FALSE);
+    }
+
+    ReadStream51();
+    return(BlockJump(TOKEN_ELSE));
+}
+
+
 BIT DoIfCmd(void)
 {
-    // save false address
-    wArg[2] = (WORD)(GetStreamAddr() + ReadStream51());
+    // save false address, offset is from the byte after it
+    wArg[2] = ReadStream51();
+    wArg[2] += GetStreamAddr();
 
     GetSimpleExpr();  // CurChar is token that stopped the scan
-    if (uData.LVal == 0)   // Make FALSE jump to ELSE or end of line
+    if (CurChar == TOKEN_BEGIN)   // block IF
+    {
+        if (uData.LVal == 0) return(BlockJump(TOKEN_BEGIN));
+        StreamSkip(4);    // skip link
+        CurChar = TOKEN_COLON;
+    }
+    else if (uData.LVal == 0)   // Make FALSE jump to ELSE or end of line
     {
         SetStream51(wArg[2]);
         CurChar = TOKEN_COLON;
@@ -474,3 +836,423 @@ BIT DoIfCmd(void)
 }
 
 
+// WHILE AND DO LOOPS
+// WHILE <expression> ... WEND
+// DO ... LOOP [WHILE <expression> | UNTIL <expression>]
+// A loop keeps a frame on the FOR_GOSUB stack the way FOR does, a GOSUB
+// structure holding the address to go back to and its line, so WEND and
+// LOOP jump back without looking anything up.  For WHILE that address is
+// the condition, so WEND tests it and carries on into the body or leaves
+// the loop in one step.  A WHILE that is false from the start has no frame
+// yet and goes past its WEND using the link after the WHILE token.
+
+
+// Evaluate the condition of a loop, which must end the statement.
+// Return TRUE on error, otherwise uData.LVal is zero if it is false.
+
+static BIT LoopCondition(void)
+{
+    BYTE Token;
+
+    Token = GetSimpleExpr();
+    if (Token == TOKEN_FLOAT_CONST) uData.LVal = (uData.fVal != 0);
+    else if (Token != TOKEN_INTL_CONST) return(TRUE);
+
+    return((BIT) !TerminalChar());
+}
+
+
+BIT DoWhileCmd(void)
+{
+    WORD LinkAddr;
+
+    LinkAddr = GetStreamAddr();
+    StreamSkip(4);    // skip link
+    if (LoopCondition()) return(TRUE);
+
+    if (uData.LVal == 0)   // never enter the loop
+    {
+        SetStream51(LinkAddr);
+        return(BlockJump(TOKEN_WHILE));
+    }
+
+    gReturn.ReturnPtr = (WORD)(LinkAddr + 4);   // the condition
+    gReturn.Line = LineNo;
+    return(PushStruct(TOKEN_WHILE));
+}
+
+
+BIT DoWendCmd(void)
+{
+    WORD Addr, Line;
+
+    if (!GetTerminalToken()) return(TRUE);
+
+    // Where to go when the loop is done
+    Addr = GetReturnAddress();
+    Line = gReturn.Line;
+
+    if (GetLoop(TOKEN_WHILE))
+    {
+        SyntaxErrorCode = ERROR_NOT_ALLOWED_HERE;   // no WHILE
+        return(TRUE);
+    }
+
+    // Test the condition again, where the WHILE is
+    SetStream51(gReturn.ReturnPtr);
+    LineNo = gReturn.Line;
+    if (LoopCondition()) return(TRUE);
+    if (uData.LVal) return(FALSE);   // go on with the body
+
+    PopLoop();
+    uData.wVal[0] = Addr;
+    uData.wVal[1] = Line;
+    GotoHelper(FALSE);
+
+    return(FALSE);
+}
+
+
+BIT DoDoCmd(void)
+{
+    if (!GetTerminalToken()) return(TRUE);
+
+    GetReturnAddress();   // the statement after DO
+    return(PushStruct(TOKEN_DO));
+}
+
+
+BIT DoLoopCmd(void)
+{
+    BIT Jump, Until;
+
+    Jump = TRUE;    // a plain LOOP always goes back
+    if (!GetTerminalToken())
+    {
+        // LOOP WHILE goes back while the condition is true, UNTIL while false
+        Until = (BIT)(CurChar == TOKEN_UNTIL);
+        if (!Until && CurChar != TOKEN_LOOP_WHILE) return(TRUE);
+
+        if (LoopCondition()) return(TRUE);
+        Jump = (BIT)((uData.LVal != 0) != Until);
+    }
+
+    if (GetLoop(TOKEN_DO))
+    {
+        SyntaxErrorCode = ERROR_NOT_ALLOWED_HERE;   // no DO
+        return(TRUE);
+    }
+
+    if (Jump)
+    {
+        uData.wVal[0] = gReturn.ReturnPtr;
+        uData.wVal[1] = gReturn.Line;
+        GotoHelper(FALSE);
+    }
+    else PopLoop();
+
+    return(FALSE);
+}
+
+
+// SELECT CASE
+// SELECT CASE <expression>
+// CASE <expression> [, <expression> ...]
+// ...
+// CASE ELSE
+// ...
+// END SELECT
+// The statements after the first CASE with a value equal to the selector
+// are run, or the ones after CASE ELSE if none is.  They end at the next
+// CASE, which jumps past the END SELECT with its link the way a block ELSE
+// does.  The link after the CASE of SELECT CASE says how to find the case
+// instead: 0 before the SELECT has been run, CASE_SEQUENTIAL to test the
+// cases one after the other like an IF ladder, or the number of a jump
+// table in CaseTable[] plus 1.  A table is made the first time the SELECT
+// runs if every case is an integer constant and they are no more than
+// CASE_MAX_SPAN apart, so a state machine goes straight to its state however
+// many there are.  UnlinkProgram() frees the tables along with the links
+// to them, so they are made again the next time each SELECT runs.
+
+#ifdef __C51__
+#define CASE_TABLES       2
+#define CASE_ENTRIES      32
+#else
+#define CASE_TABLES       64
+#define CASE_ENTRIES      4096
+#endif
+
+#define CASE_MAX_SPAN     256      // most values one table covers
+#define CASE_SEQUENTIAL   0xFFFF   // link of a SELECT with no table
+
+typedef struct
+{
+    long Min;         // Value of the first entry
+    WORD Count;       // Number of entries
+    WORD First;       // Index of the first entry in CaseAddr[]
+    WORD ElseAddr;    // Where a value with no entry goes
+    WORD ElseLine;
+} CASE_TABLE;
+
+XDATA CASE_TABLE CaseTable[CASE_TABLES];
+XDATA WORD CaseAddr[CASE_ENTRIES];   // Where each value goes, 0 if no CASE
+XDATA WORD CaseLine[CASE_ENTRIES];
+
+
+// Read one item of a CASE list for a jump table.  Return the token after
+// it, a comma or the end of the statement, with the value in uData.LVal,
+// or 0 if the item is not an integer constant.
+
+static BYTE CaseItem(void)
+{
+    BYTE Token;
+    BIT Minus;
+    long Value;
+
+    Token = GetNextToken();
+    Minus = (BIT)(Token == TOKEN_UNARY_MINUS);
+    if (Minus) Token = GetNextToken();
+    if (Token != TOKEN_INTL_CONST) return(0);
+
+    Value = uData.LVal;
+    Token = GetNextToken();
+    if (Token != TOKEN_COMMA && Token != TOKEN_COLON && Token != '\r')
+        return(0);
+
+    uData.LVal = Minus ? -Value : Value;
+    return(Token);
+}
+
+
+// Make a jump table for the SELECT whose cases start at the stream.  The
+// cases are scanned twice, once to check them and find the range of values
+// and once to fill in the entries.  The target of a case is the end of its
+// CASE statement.
+// Return the number of the table plus 1, or CASE_SEQUENTIAL if there can't
+// be one.  The stream and LineNo are left anywhere.
+
+static WORD MakeCaseTable(void)
+{
+    WORD Start, Line, Addr, Target, First, i;
+    BYTE Token, n;
+    BIT Fill, Any;
+    long Min, Max;
+
+    if (CaseTables == CASE_TABLES) return(CASE_SEQUENTIAL);
+    n = CaseTables;
+
+    Start = GetStreamAddr();
+    Line = LineNo;
+    Min = Max = 0;
+    Any = FALSE;
+    First = CaseEntries;
+    Fill = FALSE;
+    while (1)
+    {
+        SetStream51(Start);
+        LineNo = Line;
+        CaseTable[n].ElseAddr = 0;
+
+        while ((Token = NextCase()) == TOKEN_CASE)
+        {
+            if (PeekStream51() == TOKEN_ELSE)   // CASE ELSE
+            {
+                GetNextToken();
+                if (CaseTable[n].ElseAddr == 0)
+                {
+                    CaseTable[n].ElseAddr = GetStreamAddr();
+                    CaseTable[n].ElseLine = LineNo;
+                }
+                continue;
+            }
+
+            // Find the end of the statement, checking the items
+            Addr = GetStreamAddr();
+            do
+            {
+                Token = CaseItem();
+                if (Token == 0) return(CASE_SEQUENTIAL);
+                if (!Any || uData.LVal < Min) Min = uData.LVal;
+                if (!Any || uData.LVal > Max) Max = uData.LVal;
+                Any = TRUE;
+            } while (Token == TOKEN_COMMA);
+
+            if (Fill)   // read the items again and point them at the end
+            {
+                Target = (WORD)(GetStreamAddr() - 1);
+                SetStream51(Addr);
+                do
+                {
+                    Token = CaseItem();
+                    i = First + (WORD)((DWORD) uData.LVal - (DWORD) Min);
+                    if (CaseAddr[i] == 0)   // the first CASE wins
+                    {
+                        CaseAddr[i] = Target;
+                        CaseLine[i] = LineNo;
+                    }
+                } while (Token == TOKEN_COMMA);
+            }
+
+            // Let NextCase() see the end of the line
+            SetStream51((WORD)(GetStreamAddr() - 1));
+        }
+
+        if (Token == 0) return(CASE_SEQUENTIAL);   // no END SELECT
+        if (Fill) break;
+
+        // Is there room for the range of values
+        if ((DWORD) Max - (DWORD) Min >= CASE_MAX_SPAN) return(CASE_SEQUENTIAL);
+        CaseTable[n].Count = Any ? (WORD)(Max - Min + 1) : 0;
+        if (CaseTable[n].Count > CASE_ENTRIES - CaseEntries)
+            return(CASE_SEQUENTIAL);
+
+        for (i = 0; i < CaseTable[n].Count; i++) CaseAddr[First + i] = 0;
+        Fill = TRUE;
+    }
+
+    // Without CASE ELSE other values go past the END SELECT
+    if (CaseTable[n].ElseAddr == 0)
+    {
+        CaseTable[n].ElseAddr = GetStreamAddr();
+        CaseTable[n].ElseLine = LineNo;
+    }
+
+    CaseTable[n].Min = Min;
+    CaseTable[n].First = First;
+    CaseEntries += CaseTable[n].Count;
+    CaseTables++;
+
+    return((WORD)(n + 1));
+}
+
+
+// Run the SELECT with jump table n - 1 for the selector in uData, of type
+// Token.  A float selector with a fraction has no entry.
+
+static void CaseJump(WORD n, BYTE Token)
+{
+    DWORD i;
+    long Value;
+
+    n--;
+    i = CaseTable[n].Count;   // no entry
+    if (Token == TOKEN_INTL_CONST)
+        i = (DWORD) uData.LVal - (DWORD) CaseTable[n].Min;
+    else
+    {
+        Value = (long) uData.fVal;
+        if ((float) Value == uData.fVal)
+            i = (DWORD) Value - (DWORD) CaseTable[n].Min;
+    }
+
+    if (i < CaseTable[n].Count && CaseAddr[CaseTable[n].First + (WORD) i])
+    {
+        uData.wVal[0] = CaseAddr[CaseTable[n].First + (WORD) i];
+        uData.wVal[1] = CaseLine[CaseTable[n].First + (WORD) i];
+    }
+    else
+    {
+        uData.wVal[0] = CaseTable[n].ElseAddr;
+        uData.wVal[1] = CaseTable[n].ElseLine;
+    }
+    GotoHelper(FALSE);
+}
+
+
+BIT DoSelectCmd(void)
+{
+    WORD LinkAddr, Start, Line, n;
+    BYTE Token;
+    BIT Integer, Match;
+    long LVal;
+    float fVal;
+
+    if (ReadStream51() != TOKEN_CASE) return(TRUE);   // SELECT CASE
+    LinkAddr = GetStreamAddr();
+    n = (WORD)((DWORD) ReadStreamLong() >> 16);
+
+    Token = GetSimpleExpr();
+    if (Token != TOKEN_INTL_CONST && Token != TOKEN_FLOAT_CONST)
+    {
+        if (SyntaxErrorCode == 0) SyntaxErrorCode = ERROR_TYPE_CONFLICT;
+        return(TRUE);
+    }
+    if (!TerminalChar()) return(TRUE);
+
+    // Start the scans at the end of the statement
+    Start = (WORD)(GetStreamAddr() - 1);
+    SetStream51(Start);
+    Line = LineNo;
+
+    if (n == 0 && CanLink(LinkAddr))   // first time, link it
+    {
+        LVal = uData.LVal;    // save the selector
+        n = MakeCaseTable();
+        LinkConst(LinkAddr, n, 0);
+        uData.LVal = LVal;
+    }
+
+    if (n != 0 && n != CASE_SEQUENTIAL)
+    {
+        CaseJump(n, Token);
+        return(FALSE);
+    }
+
+    // Test the cases one after the other
+    Integer = (BIT)(Token == TOKEN_INTL_CONST);
+    LVal = uData.LVal;
+    fVal = Integer ? (float) uData.LVal : uData.fVal;
+    Match = FALSE;
+
+    SetStream51(Start);
+    LineNo = Line;
+    while ((Token = NextCase()) == TOKEN_CASE)
+    {
+        if (PeekStream51() == TOKEN_ELSE)   // CASE ELSE
+        {
+            GetNextToken();
+            CurChar = TOKEN_COLON;
+            return(FALSE);
+        }
+
+        do
+        {
+            Token = GetSimpleExpr();
+            if (Token == TOKEN_INTL_CONST && Integer)
+                Match |= (BIT)(uData.LVal == LVal);
+            else if (Token == TOKEN_INTL_CONST)
+                Match |= (BIT)((float) uData.LVal == fVal);
+            else if (Token == TOKEN_FLOAT_CONST)
+                Match |= (BIT)(uData.fVal == fVal);
+            else
+            {
+                if (SyntaxErrorCode == 0) SyntaxErrorCode = ERROR_TYPE_CONFLICT;
+                return(TRUE);
+            }
+        } while (CurChar == TOKEN_COMMA);
+
+        if (!TerminalChar()) return(TRUE);
+        if (Match) return(FALSE);   // run this case
+
+        SetStream51((WORD)(GetStreamAddr() - 1));
+    }
+
+    if (Token == 0)
+    {
+        LineNo = Line;
+        SyntaxErrorCode = ERROR_SYNTAX;   // no END SELECT
+        return(TRUE);
+    }
+
+    CurChar = TOKEN_COLON;    // go on after END SELECT
+    return(FALSE);
+}
+
+
+// CASE at the end of the statements of the case before it
+
+BIT DoCaseCmd(void)
+{
+    return(BlockJump(TOKEN_CASE));
+}
+
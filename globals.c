@@ -30,6 +30,9 @@ GLOBALS.C - This is where all the globals are stored.
 
 
 #include "bas51.h"
+#include "ext_tokens.h"
+#include "stats.h"
+#include "cost51.h"
 
 BYTE SyntaxErrorCode;   // Set to error enum value defined in bas51.h
 XDATA BYTE InBuf[256];
@@ -61,6 +64,13 @@ WORD wArg[UDATA + 1];
 BYTE DefTypes[26];   // default types
 BYTE KeyFlags;       // Flags set with keystrokes
 DWORD ScreenTicks;
+BYTE ExitStatus;     // Last error reported to the user, exit code for --run
+#ifndef __C51__
+DWORD Stats[STAT_COUNT];   // Hot path counters, see stats.h
+#endif
+#ifdef BAS51_COST
+DWORD Cycles51;            // Estimated 8051 cycles, see cost51.h
+#endif
 
 
 
@@ -255,6 +265,30 @@ BYTE CommandTokenTable[] =
 };
 
 
+// Statements added later, see ext_tokens.h.  MatchToken() searches this
+// table first, so a name here may begin with the name of an older token
+// (like ENDIF and END), but must not be the beginning of one.  A name here
+// is only a keyword when it isn't followed by more of a variable name.
+
+CODE BYTE ExtTokenTable[] =
+{
+    'S'+128,'N','A','P','S','H','O','T',    // "SNAPSHOT"
+    'P'+128,'R','O','F','I','L','E',        // "PROFILE"
+    'S'+128,'T','A','T','S',                // "STATS"
+    'E'+128,'N','D','I','F',                // "ENDIF"
+    'W'+128,'H','I','L','E',                // "WHILE"
+    'W'+128,'E','N','D',                    // "WEND"
+    'D'+128,'O',                            // "DO"
+    'L'+128,'O','O','P',                    // "LOOP"
+    'U'+128,'N','T','I','L',                // "UNTIL"
+    'W'+128,'H','I','L','E',                // "WHILE" after LOOP, never matched
+    'S'+128,'E','L','E','C','T',            // "SELECT"
+    'C'+128,'A','S','E',                    // "CASE"
+
+    128               // marks end of table
+};
+
+
 
 
 
@@ -319,6 +353,7 @@ void PrintErrorCode(void)
         if (LineNo != 0xFFFF) VGA_printf(" in Line %d", LineNo);
         VGA_print("\n\n");
 
+        ExitStatus = SyntaxErrorCode;
         SyntaxErrorCode = ERROR_NONE;  // reset for next error
     }
 
@@ -608,10 +643,12 @@ BYTE FontLines[14][256] =  {   // Font Line 1
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00  // 240 to 255
 } };
 
-BYTE VIDEO_MEMORY[2048];
+#endif   // WIN32
 
 
-#endif   // WIN32
+#if defined(__WIN32__) || defined(__unix__)
+BYTE VIDEO_MEMORY[2048];
+#endif
 
 
 
@@ -32,6 +32,10 @@ GRAPHICS.C - Routines that output to the screen.
 #include "bas51.h"
 #include <stdarg.h>
 
+#ifdef __unix__
+void ConsolePutChar(BYTE ch);   // drivers.c - copies screen output to stdout
+#endif
+
 
 
 
@@ -132,6 +136,10 @@ void VGA_PutRawChar(BYTE ch)
 
 void VGA_putchar(BYTE ch)
 {
+#ifdef __unix__
+    ConsolePutChar(ch);
+#endif
+
     if (ch == '\n')     // special non-printing newline
     {
         CurPosX = 0;
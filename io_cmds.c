@@ -30,6 +30,7 @@ IO_CMDS.C - Routines that pertain to BASIC input ansd output.
 
 
 #include "bas51.h"
+#include "ext_tokens.h"
 
 // Get an expression parameter from the stream of a specific type.
 // Automatically convert INTL and FLOAT types.
@@ -760,10 +761,14 @@ BIT DoLineInputCmd(void)
 
 // Set Data Pointer to a specific line - Set to the begining if no line.
 // Returns error if anything else on line.
+// RESTORE SNAPSHOT "name" is handled by DoRestoreSnapshotCmd().
+
+BIT DoRestoreSnapshotCmd(void);
 
 BIT DoRestoreCmd(void)
 {
     CurChar = GetNextToken();
+    if (CurChar == TOKEN_SNAPSHOT) return(DoRestoreSnapshotCmd());
     if (TerminalChar())   // retore to begining if no line num
     {
         DATAptr = 0;
@@ -805,6 +810,360 @@ void DoListFilesCmd(void)
     VGA_printf("\n\n%d files found\n", Count);
 }
 
+// LOAD reads the file in blocks and builds each line in InBuf[] rather
+// than reading it a byte at a time through the screen.  The lines are only
+// echoed to the screen when LoadEcho is set.
+
+#ifndef LOAD_BLOCK_SIZE
+#ifdef __C51__
+#define LOAD_BLOCK_SIZE 64
+#else
+#define LOAD_BLOCK_SIZE 1024
+#endif
+#endif
+
+XDATA BYTE LoadBlock[LOAD_BLOCK_SIZE];
+WORD LoadPos, LoadCount;
+BIT LoadEcho = TRUE;     // FALSE to load without listing the file
+
+WORD BasReadBlock(BYTE *Buf, WORD Len);   // drivers.c
+void StartBulkLoad(void);                 // editor.c
+BIT BulkLineExists(WORD Line);            // editor.c
+BIT BulkStoreLine(void);                  // editor.c
+void EndBulkLoad(void);                   // editor.c
+
+// Read the next line of the open file into InBuf[] without its newline.
+// Tabs become spaces.  Return the length of the line, 0xFFFF at the end of
+// the file, or 0xFFFE if the line does not fit in InBuf[].
+
+WORD ReadLoadLine(void)
+{
+    WORD Len;
+    BYTE B;
+
+    Len = 0;
+    while (1)
+    {
+        if (LoadPos == LoadCount)
+        {
+            LoadCount = BasReadBlock(LoadBlock, LOAD_BLOCK_SIZE);
+            LoadPos = 0;
+            if (LoadCount == 0)   // end of file
+            {
+                // The last line may not have a newline
+                return((WORD)(Len ? Len : 0xFFFF));
+            }
+        }
+
+        B = LoadBlock[LoadPos++];
+        if (B == '\r') continue;     // ignore returns
+        if (B == '\n') return(Len);
+        if (Len == sizeof(InBuf) - 1) return(0xFFFE);   // need room for 0
+        if (B == '\t') B = ' ';
+        InBuf[Len++] = B;
+    }
+}
+
+
+// BINARY PROGRAM IMAGES
+// SAVE "name",B writes the program region exactly as it is in RAM, after a
+// short header, and LOAD "name",B reads it straight back without going
+// through the tokenizer.  The line number constants are stored unlinked.
+// Numbers in the program are in the byte order of the machine that saved
+// it, so an image can only be loaded by a build with the same byte order
+// and the same BasicVars layout.
+
+#define B51_VERSION    1
+#define B51_BYTE_ORDER 0x5142    // reads back as 0x4251 on the other endian
+
+typedef struct
+{
+    BYTE Magic[3];       // "B51"
+    BYTE Version;        // B51_VERSION
+    WORD ByteOrder;      // B51_BYTE_ORDER
+    WORD VarsSize;       // sizeof(BasicVars)
+    WORD ProgLen;        // VarStart - ProgStart
+    WORD Crc;            // CRC16 of the program region
+} B51_HEADER;
+
+void UnlinkProgram(void);                 // flow_cmds.c
+void InvalidateLineIndex(void);           // editor.c
+BIT BasWriteBlock(BYTE *Buf, WORD Len);   // drivers.c
+WORD UpdateCRC(WORD CRC_acc, BYTE CRC_input);   // vars.c
+extern BIT DetokError;                    // tokenizer.c
+
+
+// Check for ",B" after a file name.  CurChar is the token that ended the
+// file name expression.  The file name in uData is preserved.
+// Return 1 if it is there, 0 if not and 0xFF if something else is.
+
+BYTE GetBinaryOption(void)
+{
+    UVAL_DATA Name;
+    BYTE Ret;
+
+    if (CurChar != TOKEN_COMMA) return(0);
+
+    Name = uData;
+    Ret = 0xFF;
+    CurChar = GetNextToken();
+    if (CurChar == TOKEN_NOTYPE_VAR && uHash.str.Len == 0 &&
+        uHash.str.First == 'B' - 'A') Ret = 1;
+    uData = Name;
+    return(Ret);
+}
+
+
+// Load a program image from the open file into the (cleared) program
+// space.  Return TRUE with SyntaxErrorCode set on error.
+
+BIT LoadProgramImage(void)
+{
+    B51_HEADER Head;
+    WORD Addr, End, Crc, i;
+    BYTE Len;
+
+    if (BasReadBlock((BYTE *) &Head, sizeof(Head)) != sizeof(Head) ||
+        memcmp(Head.Magic, "B51", 3) != 0 || Head.Version != B51_VERSION ||
+        Head.ByteOrder != B51_BYTE_ORDER || Head.VarsSize != sizeof(BasicVars))
+        goto BadFile;
+
+    if (Head.ProgLen > (WORD)(BasicVars.StringBot - BasicVars.ProgStart))
+    {
+        SyntaxErrorCode = ERROR_INSUFFICIENT_MEMORY;
+        return(TRUE);
+    }
+
+    Crc = 0xFFFF;
+    End = (WORD)(BasicVars.ProgStart + Head.ProgLen);
+    for (Addr = BasicVars.ProgStart; Addr != End; Addr += Len)
+    {
+        Len = (BYTE) min(End - Addr, 255);
+        if (BasReadBlock(LoadBlock, Len) != Len) goto BadFile;
+        for (i = 0; i != Len; i++) Crc = UpdateCRC(Crc, LoadBlock[i]);
+        WriteBlock51(Addr, LoadBlock, Len);
+    }
+    if (Crc != Head.Crc) goto BadFile;
+
+    BasicVars.VarStart = End;
+    InvalidateLineIndex();
+    ClearVariables();
+    return(FALSE);
+
+BadFile:
+    ClearEverything();    // don't leave half a program behind
+    SyntaxErrorCode = ERROR_FILE_IO;
+    return(TRUE);
+}
+
+
+// Write the program as an image to the open file.  Return TRUE on error.
+
+BIT SaveProgramImage(void)
+{
+    B51_HEADER Head;
+    WORD Addr, i;
+    BYTE Len;
+
+    UnlinkProgram();   // save plain line numbers, not addresses
+
+    memcpy(Head.Magic, "B51", 3);
+    Head.Version = B51_VERSION;
+    Head.ByteOrder = B51_BYTE_ORDER;
+    Head.VarsSize = sizeof(BasicVars);
+    Head.ProgLen = (WORD)(BasicVars.VarStart - BasicVars.ProgStart);
+    Head.Crc = 0xFFFF;
+    for (Addr = BasicVars.ProgStart; Addr != BasicVars.VarStart; Addr += Len)
+    {
+        Len = (BYTE) min(BasicVars.VarStart - Addr, 255);
+        ReadBlock51(LoadBlock, Addr, Len);
+        for (i = 0; i != Len; i++) Head.Crc = UpdateCRC(Head.Crc, LoadBlock[i]);
+    }
+
+    if (BasWriteBlock((BYTE *) &Head, sizeof(Head))) return(TRUE);
+    for (Addr = BasicVars.ProgStart; Addr != BasicVars.VarStart; Addr += Len)
+    {
+        Len = (BYTE) min(BasicVars.VarStart - Addr, 255);
+        ReadBlock51(LoadBlock, Addr, Len);
+        if (BasWriteBlock(LoadBlock, Len)) return(TRUE);
+    }
+    return(FALSE);
+}
+
+
+// SNAPSHOTS
+// SNAPSHOT "name" saves everything needed to carry on from the next
+// statement: all of RAM (program, variables, arrays, the FOR/GOSUB stack
+// and strings), BasicVars, the DEF types, the stream position and the
+// screen.  RESTORE SNAPSHOT "name" puts it all back and continues from
+// there, as does starting bas51 with --resume.  The line number constants
+// are saved unlinked and the host side caches are rebuilt on restore.
+
+#define S51_VERSION    1
+
+typedef struct
+{
+    BYTE Magic[3];       // "S51"
+    BYTE Version;        // S51_VERSION
+    WORD ByteOrder;      // B51_BYTE_ORDER
+    WORD VarsSize;       // sizeof(BasicVars)
+    WORD RamTop;         // RAM saved is 0 - RamTop
+    WORD StreamAddr;     // Next byte to execute
+    WORD LineNo;
+    WORD DATAptr;
+    WORD StopLinePtr;
+    BYTE CurChar;
+    BYTE CurPosX, CurPosY;
+    BYTE DefTypes[26];
+    BASIC_VARS_TYPE Vars;
+} S51_HEADER;
+
+void ClearExprCache(void);                // expression.c
+void ClearVMCache(void);                  // command.c
+void RebuildVarIndex(void);               // vars.c
+void InvalidateCtlStack(void);            // stacks.c
+void ForgetLinks(void);                   // flow_cmds.c
+
+
+// Get the file name for SNAPSHOT and RESTORE SNAPSHOT and open the file.
+// Return TRUE with SyntaxErrorCode set on error.
+
+BIT OpenSnapshot(BIT ReadFlag)
+{
+    if (GetSimpleExpr() != TOKEN_STRING_CONST)
+    {
+        if (SyntaxErrorCode == ERROR_NONE) SyntaxErrorCode = ERROR_TYPE_CONFLICT;
+        return(TRUE);
+    }
+    if (!TerminalChar())
+    {
+        SyntaxErrorCode = ERROR_SYNTAX;
+        return(TRUE);
+    }
+    if (BasFileOpen(ReadFlag))
+    {
+        SyntaxErrorCode = (BYTE)(ReadFlag ? ERROR_NOT_FOUND_FILE : ERROR_FILE_IO);
+        return(TRUE);
+    }
+    return(FALSE);
+}
+
+
+BIT DoSnapshotCmd(void)
+{
+    S51_HEADER Head;
+    DWORD Addr;
+    BYTE Len;
+
+    if (OpenSnapshot(FALSE)) return(TRUE);
+
+    UnlinkProgram();   // RAM must not hold addresses of linked lines
+
+    memcpy(Head.Magic, "S51", 3);
+    Head.Version = S51_VERSION;
+    Head.ByteOrder = B51_BYTE_ORDER;
+    Head.VarsSize = sizeof(BasicVars);
+    Head.RamTop = BasicVars.RamTop;
+    Head.StreamAddr = GetStreamAddr();
+    Head.LineNo = LineNo;
+    Head.DATAptr = DATAptr;
+    Head.StopLinePtr = StopLinePtr;
+    Head.CurChar = CurChar;
+    Head.CurPosX = CurPosX;
+    Head.CurPosY = CurPosY;
+    memcpy(Head.DefTypes, DefTypes, sizeof(DefTypes));
+    Head.Vars = BasicVars;
+
+    if (BasWriteBlock((BYTE *) &Head, sizeof(Head)) ||
+        BasWriteBlock(VIDEO_MEMORY, sizeof(VIDEO_MEMORY)))
+        goto Error;
+
+    for (Addr = 0; Addr <= BasicVars.RamTop; Addr += Len)
+    {
+        Len = (BYTE) min(BasicVars.RamTop - Addr + 1, 255);
+        ReadBlock51(LoadBlock, (WORD) Addr, Len);
+        if (BasWriteBlock(LoadBlock, Len)) goto Error;
+    }
+
+    BasFileClose();
+    SetStream51(Head.StreamAddr);   // writes may have moved the stream
+    return(FALSE);
+
+Error:
+    BasFileClose();
+    SetStream51(Head.StreamAddr);
+    SyntaxErrorCode = ERROR_FILE_IO;
+    return(TRUE);
+}
+
+
+// RESTORE SNAPSHOT "name".  On success the stream is left where the
+// snapshot was taken and CurChar is what it was then.
+
+BIT DoRestoreSnapshotCmd(void)
+{
+    S51_HEADER Head;
+    DWORD Addr;
+    BYTE Len;
+
+    if (OpenSnapshot(TRUE)) return(TRUE);
+
+    if (BasReadBlock((BYTE *) &Head, sizeof(Head)) != sizeof(Head) ||
+        memcmp(Head.Magic, "S51", 3) != 0 || Head.Version != S51_VERSION ||
+        Head.ByteOrder != B51_BYTE_ORDER || Head.VarsSize != sizeof(BasicVars))
+    {
+        BasFileClose();
+        SyntaxErrorCode = ERROR_FILE_IO;
+        return(TRUE);
+    }
+    if (Head.RamTop > BasicVars.RamTop)
+    {
+        BasFileClose();
+        SyntaxErrorCode = ERROR_INSUFFICIENT_MEMORY;
+        return(TRUE);
+    }
+
+    // From here on the old state is gone
+    if (BasReadBlock(VIDEO_MEMORY, sizeof(VIDEO_MEMORY)) != sizeof(VIDEO_MEMORY))
+        goto Error;
+    for (Addr = 0; Addr <= Head.RamTop; Addr += Len)
+    {
+        Len = (BYTE) min(Head.RamTop - Addr + 1, 255);
+        if (BasReadBlock(LoadBlock, Len) != Len) goto Error;
+        WriteBlock51((WORD) Addr, LoadBlock, Len);
+    }
+    BasFileClose();
+
+    BasicVars = Head.Vars;
+    memcpy(DefTypes, Head.DefTypes, sizeof(DefTypes));
+    LineNo = Head.LineNo;
+    DATAptr = Head.DATAptr;
+    StopLinePtr = Head.StopLinePtr;
+    CurPosX = Head.CurPosX;
+    CurPosY = Head.CurPosY;
+    UPDATE_DISPLAY;
+
+    // Nothing the host remembered about the old program is any good
+    ForgetLinks();
+    InvalidateLineIndex();
+    ClearExprCache();
+    ClearVMCache();
+    RebuildVarIndex();
+    InvalidateCtlStack();
+
+    SetStream51(Head.StreamAddr);
+    CurChar = Head.CurChar;
+    Running = TRUE;
+    return(FALSE);
+
+Error:
+    BasFileClose();
+    ClearEverything();
+    Running = FALSE;
+    SyntaxErrorCode = ERROR_FILE_IO;
+    return(TRUE);
+}
+
 BIT DoLoadFileCmd(void)
 {
     BYTE Token;
@@ -834,101 +1193,117 @@ BIT DoLoadFileCmd(void)
     	goto Error;
     }
 
+    Token = GetBinaryOption();
+    if (Token == 0xFF)
+    {
+	    SyntaxErrorCode = ERROR_SYNTAX;
+    	goto Error;
+    }
+
     if (BasFileOpen(TRUE))
     {
 	    SyntaxErrorCode = ERROR_NOT_FOUND_FILE;
     	goto Error;   // True for reading
     }
 
-    NewLineFlag = TRUE;
-    while ((W = BasReadByte()) != 0xFFFF)
+    if (Token)   // binary image
+    {
+        Token = (BYTE) LoadProgramImage();
+        BasFileClose();
+        if (Token) goto Error;
+        return(FALSE);
+    }
+
+    StartBulkLoad();
+    LoadPos = LoadCount = 0;
+    while ((W = ReadLoadLine()) != 0xFFFF)
     {
-        if (NewLineFlag)
+        WORD Line;
+        BYTE *Buf;
+
+        if (W == 0xFFFE)
         {
-            // Mark the field start
-            FieldStart = (WORD)(CurPosY * VID_COLS + CurPosX);
-            FieldLen = 0;
-            NewLineFlag = FALSE;
+            SyntaxErrorCode = ERROR_LINE_TOO_LONG;
+            goto Error2;
         }
 
-        // Newline character starts processing.
-        if (W == '\n')
+        if (LoadEcho)
         {
-        	WORD Line;
-            BYTE B;
+            for (Line = 0; Line < W; Line++) VGA_putchar(InBuf[Line]);
+        }
 
-            // prepare for next line
-   	        NewLineFlag = TRUE;
+        // Skip leading spaces
+        Buf = InBuf;
+        while (W && *Buf == ' ')
+        {
+            Buf++;
+            W--;
+        }
 
-            // Skip leading spaces
-            while ((B = VIDEO_MEMORY[FieldStart]) == ' ' || B == '\t')
-                FieldStart++;
+        // check for secret comments
+        if (W && *Buf == ';') goto SkipLine;
 
-            // check for secret comments
-            if (VIDEO_MEMORY[FieldStart] == ';') goto SkipLine;
+        // Convert to tokenized form
+        if (TokenizeLine(Buf, (BYTE) W)) goto Error2;
 
-            // Convert to tokenized form
-            if (TokenizeLine(&VIDEO_MEMORY[FieldStart], FieldLen)) goto Error2;
+        // check for blank lines and don't store them
+        if (TokBuf[2] > 1)  // blank line still has '\r'
+        {
+            // Get the Line number
+            Line = (WORD)(((WORD) TokBuf[0] << 8) | (WORD) TokBuf[1]);
 
-            // check for blank lines and don't store them
-            if (TokBuf[2] > 1)  // blank line still has '\r'
+            if (Line == 0xFFFF)   // no line number specified
             {
-	            // Get the Line number
-			 	Line = (WORD)(((WORD) TokBuf[0] << 8) | (WORD) TokBuf[1]);
-
-        	    if (Line == 0xFFFF)   // no line number specified
-            	{
-                    // Special case for RUN command
-                    if (TokBuf[3] == TOKEN_AUTO && TokBuf[4] == TOKEN_RUN)
-                    {
-                        Running = TRUE;
-                        continue;
-                    }
-                    else goto SupplyNewLineNumber;
-            	}
-
-	            // Check if line already exists
-				if (FindLinePtr(Line, TRUE))    // Error: Line already exists
+                // Special case for RUN command
+                if (TokBuf[3] == TOKEN_AUTO && TokBuf[4] == TOKEN_RUN)
                 {
-SupplyNewLineNumber:
-           			// Change to last line number plus 10
-                	Line = (WORD)(LastLine + 10);
-	        		TokBuf[0] = (BYTE)(Line >> 8);    // High Byte
-					TokBuf[1] = (BYTE)(Line & 0xFF);  // Low Byte
+                    Running = TRUE;
+                    continue;
                 }
+                else goto SupplyNewLineNumber;
+            }
 
-            	// Print error code if any.
-	        	if (SyntaxErrorCode != ERROR_NONE) goto Error2;
+            // Check if line already exists
+            if (BulkLineExists(Line))    // Error: Line already exists
+            {
+SupplyNewLineNumber:
+                // Change to last line number plus 10
+                Line = (WORD)(LastLine + 10);
+                TokBuf[0] = (BYTE)(Line >> 8);    // High Byte
+                TokBuf[1] = (BYTE)(Line & 0xFF);  // Low Byte
+            }
 
-                if (TokBuf[3] == TOKEN_LABEL) // check for label definition
-                {
-                	// Add label to label table
-                    LabelFlag = TRUE;
-                    Label.Line = Line;
-                    memcpy(&Label.Hash[0], &TokBuf[4], 4);  // copy hash
-                    LabelTable -= (WORD) 6;  // make room
-                    WriteBlock51(LabelTable, (BYTE *) &Label, 6);
-
-                    // Make the rest of TokBuf[] a comment
-                    TokBuf[3] = TOKEN_REM;
-                    memset(&TokBuf[4], ' ', 4);  // change hash to blanks
-                    // Store modified line as usual
-                }
+            // Print error code if any.
+            if (SyntaxErrorCode != ERROR_NONE) goto Error2;
 
-            	// Save line in RAM
-	            StoreBasicLine(NULL);
+            if (TokBuf[3] == TOKEN_LABEL) // check for label definition
+            {
+                // Add label to label table
+                LabelFlag = TRUE;
+                Label.Line = Line;
+                memcpy(&Label.Hash[0], &TokBuf[4], 4);  // copy hash
+                LabelTable -= (WORD) 6;  // make room
+                WriteBlock51(LabelTable, (BYTE *) &Label, 6);
+
+                // Make the rest of TokBuf[] a comment
+                TokBuf[3] = TOKEN_REM;
+                memset(&TokBuf[4], ' ', 4);  // change hash to blanks
+                // Store modified line as usual
+            }
 
-                // Save old Line number
-        	    LastLine = Line;
+            // Save line in RAM
+            if (BulkStoreLine()) goto Error2;
 
-			}  // if not a blank line
+            // Save old Line number
+            LastLine = Line;
 
-        } // if newline char
+        }  // if not a blank line
 
 SkipLine:
-        VGA_putchar((BYTE)(W));  // increments FieldLen
+        if (LoadEcho) VGA_putchar('\n');
     }
     BasFileClose();
+    EndBulkLoad();
 
     // Pass 2 for label fixups
     if (LabelFlag)
@@ -1030,8 +1405,9 @@ SkipLine:
 
 
 Error2:
-	VGA_putchar('\n');
+	if (LoadEcho) VGA_putchar('\n');
 	BasFileClose();
+    EndBulkLoad();
 
 Error:
 	Running = FALSE;
@@ -1049,11 +1425,25 @@ BIT DoSaveFileCmd(void)
     Token = GetSimpleExpr();
     if (Token != TOKEN_STRING_CONST) goto Error;
 
+    Token = GetBinaryOption();
+    if (Token == 0xFF) goto Error3;
+
     if (BasFileOpen(FALSE)) goto Error2;   // False for Writing
 
+    if (Token)   // binary image
+    {
+        Token = (BYTE) SaveProgramImage();
+        BasFileClose();
+        if (Token) goto Error2;
+        return(FALSE);
+    }
+
+    SyntaxErrorCode = ERROR_NONE;
     ListProgram(0xFFFF, 0xFFF0);
 
     BasFileClose();
+    if (DetokError) goto Error2;
+    if (SyntaxErrorCode != ERROR_NONE) return(TRUE);
 
     return(FALSE);
 
@@ -1064,6 +1454,10 @@ Error2:
 Error:
     SyntaxErrorCode = ERROR_TYPE_CONFLICT;
     return(TRUE);
+
+Error3:
+    SyntaxErrorCode = ERROR_SYNTAX;
+    return(TRUE);
 }
 
 
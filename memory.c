@@ -33,6 +33,7 @@ are necessary.
 
 
 #include "bas51.h"
+#include "stats.h"
 
 
 // This is the memory manager for the 8051.
@@ -50,11 +51,51 @@ are necessary.
 //
 
 
-#define STREAM_BUF_SIZE    64
-BYTE StreamBuf[STREAM_BUF_SIZE];   // Stream is read 64 bytes at a time
+// FLAT_MEMORY is a compile time option for the Win32 and POSIX versions.
+// There the "external" RAM is just MemBuf[] in drivers.c, so the stream and
+// random access functions index it directly instead of going through
+// ReadBlock51() and StreamBuf[].  It is meaningless on the real hardware.
+
+#if defined(FLAT_MEMORY) && defined(__C51__)
+#error FLAT_MEMORY is only for the simulated RAM of the host versions
+#endif
+
+// The stream is read through a small set associative cache so that a loop
+// whose NEXT or RETURN is far from its target does not have to re-read the
+// program from the SPI RAM every time around.  Lines are aligned to their
+// size and each address can only live in one set.  The least recently used
+// way of the set is replaced on a miss.  Writes to RAM are copied into any
+// cached line they overlap (see StreamWriteThrough()), so the cache never
+// has to be thrown away as a whole.
+
+#ifndef STREAM_LINE_SHIFT
+#define STREAM_LINE_SHIFT  5               // 32 byte lines
+#endif
+#ifndef STREAM_SETS
+#define STREAM_SETS        4               // must be a power of 2
+#endif
+#ifndef STREAM_WAYS
+#define STREAM_WAYS        2
+#endif
+
+#define STREAM_BUF_SIZE    (1 << STREAM_LINE_SHIFT)
+#define STREAM_NO_TAG      0xFFFF          // unused line
+
+#ifndef FLAT_MEMORY
+XDATA BYTE StreamCache[STREAM_SETS][STREAM_WAYS][STREAM_BUF_SIZE];
+XDATA WORD StreamTag[STREAM_SETS][STREAM_WAYS];    // Line address >> SHIFT
+XDATA WORD StreamUsed[STREAM_SETS][STREAM_WAYS];   // LRU time stamps
+WORD StreamClock;                  // Time stamp of last line use
+WORD StreamCurTag;                 // Tag of the line in StreamBuf
+BYTE *StreamBuf;                   // Cache line the stream is reading.
+#endif
 WORD StreamBase;                   // Source address in RAM.
 BYTE StreamIdx;                    // index of next byte in StreamBuf[] to read.
-BIT  StreamDirtyFlag;              // Indicates Buffer needs to be re-read.
+
+#ifdef FLAT_MEMORY
+extern BYTE MemBuf[0x10000];       // drivers.c
+WORD StreamAddr;                   // Address of next byte to read.
+#endif
 
 
 
@@ -65,6 +106,13 @@ void MemInit51(void)
     BYTE B;
     WORD W;
 
+#ifndef FLAT_MEMORY
+    // Empty the stream cache
+    memset(StreamTag, 0xFF, sizeof(StreamTag));    // STREAM_NO_TAG
+    StreamCurTag = STREAM_NO_TAG;
+    StreamBuf = StreamCache[0][0];
+#endif
+
     // Compute RAMTOP
     B = 0xFF;
     do
@@ -104,7 +152,11 @@ WORD BytesFree(void)
 
 WORD GetStreamAddr(void)
 {
+#ifdef FLAT_MEMORY
+    return(StreamAddr);
+#else
     return((WORD)(StreamBase + StreamIdx));
+#endif
 }
 
 
@@ -113,24 +165,88 @@ WORD GetStreamAddr(void)
 
 void SetStream51(WORD addr)
 {
-    // check to see if we already have the requested address in the buffer
-    if (StreamBase == 0 ||
-        addr < StreamBase ||
-        addr >= StreamBase + STREAM_BUF_SIZE)
-            StreamDirtyFlag = TRUE;
+#ifdef FLAT_MEMORY
+    StreamAddr = addr;
+    StreamBase = addr;     // keeps "stream was set" tests working
+#else
+    WORD Tag;
+    BYTE Set, Way, Victim;
+
+    // Most jumps stay in the line we are already reading
+    Tag = (WORD)(addr >> STREAM_LINE_SHIFT);
+    if (Tag == StreamCurTag)
+    {
+        StreamIdx = (BYTE)(addr - StreamBase);
+        STAT_INC(STAT_STREAM_HITS);
+        return;
+    }
 
-    if (StreamDirtyFlag)   // we have ro read the buffer
+    // check to see if we already have the requested line in the cache
+    Set = (BYTE)(Tag & (STREAM_SETS - 1));
+    StreamClock++;
+    Victim = 0;
+    for (Way = 0; Way != STREAM_WAYS; Way++)
     {
-        ReadBlock51(StreamBuf, addr, STREAM_BUF_SIZE);
-        StreamBase = addr;
-        StreamIdx = 0;
-        StreamDirtyFlag = FALSE;
+        if (StreamTag[Set][Way] == Tag) break;
+        if ((WORD)(StreamClock - StreamUsed[Set][Way]) >
+            (WORD)(StreamClock - StreamUsed[Set][Victim])) Victim = Way;
     }
-    else
+
+    if (Way == STREAM_WAYS)   // we have to read the line
     {
-        // we already have it in the buffer
-        StreamIdx = (BYTE)(addr - StreamBase);
+        Way = Victim;
+        ReadBlock51(StreamCache[Set][Way], (WORD)(Tag << STREAM_LINE_SHIFT),
+            STREAM_BUF_SIZE);
+        StreamTag[Set][Way] = Tag;
+        STAT_INC(STAT_STREAM_REFILLS);
     }
+    else STAT_INC(STAT_STREAM_HITS);
+
+    StreamUsed[Set][Way] = StreamClock;
+    StreamCurTag = Tag;
+    StreamBuf = StreamCache[Set][Way];
+    StreamBase = (WORD)(Tag << STREAM_LINE_SHIFT);
+    StreamIdx = (BYTE)(addr - StreamBase);
+#endif
+}
+
+
+// Called by WriteBlock51() and MemClear51() whenever RAM is written so that
+// any cached copy of those bytes gets the same change.  Src == NULL means
+// the bytes were cleared to zero.
+
+void StreamWriteThrough(WORD addr, BYTE *Src, WORD Len)
+{
+#ifndef FLAT_MEMORY
+    WORD Tag, LastTag, LineAddr, Start, End;
+    BYTE Set, Way;
+
+    if (Len == 0) return;
+    Tag = (WORD)(addr >> STREAM_LINE_SHIFT);
+    LastTag = (WORD)((WORD)(addr + Len - 1) >> STREAM_LINE_SHIFT);
+    if (LastTag < Tag) LastTag = (WORD)(0xFFFF >> STREAM_LINE_SHIFT);  // wrapped
+
+    for (; Tag <= LastTag; Tag++)
+    {
+        Set = (BYTE)(Tag & (STREAM_SETS - 1));
+        for (Way = 0; Way != STREAM_WAYS; Way++)
+        {
+            if (StreamTag[Set][Way] != Tag) continue;
+
+            // Work out the part of the write that falls in this line
+            LineAddr = (WORD)(Tag << STREAM_LINE_SHIFT);
+            Start = (WORD)(addr > LineAddr ? addr - LineAddr : 0);
+            End = (WORD)(addr + Len - LineAddr);
+            if (End > STREAM_BUF_SIZE || (WORD)(addr + Len) < addr)
+                End = STREAM_BUF_SIZE;
+
+            if (Src) memcpy(&StreamCache[Set][Way][Start],
+                            Src + (LineAddr + Start - addr), End - Start);
+            else memset(&StreamCache[Set][Way][Start], 0, End - Start);
+        }
+        if (Tag == (WORD)(0xFFFF >> STREAM_LINE_SHIFT)) break;
+    }
+#endif
 }
 
 // Put back the last char read from the stream so it can be read again
@@ -144,21 +260,30 @@ void SetStream51(WORD addr)
 
 BYTE PeekStream51(void)
 {
+#ifdef FLAT_MEMORY
+    return(MemBuf[StreamAddr]);
+#else
+    if (StreamIdx != STREAM_BUF_SIZE) return(StreamBuf[StreamIdx]);
     return(ReadRandom51(GetStreamAddr()));
+#endif
 }
 
 // Returns the next byte from the stream.
 
 BYTE ReadStream51(void)
 {
+#ifdef FLAT_MEMORY
+    return(MemBuf[StreamAddr++]);
+#else
     if (StreamIdx == STREAM_BUF_SIZE)
     {
-        // we have to read another 64 bytes into the buffer
+        // move on to the next cache line
         SetStream51((WORD)(StreamBase + STREAM_BUF_SIZE));
     }
 
     // just return the next byte in buffer without incrementing
     return(StreamBuf[StreamIdx++]);
+#endif
 }
 
 // Read two bytes from the stream as a WORD
@@ -166,8 +291,13 @@ WORD ReadStreamWord(void)
 {
     WORD X;
 
+#ifdef FLAT_MEMORY
+    X = (WORD)((MemBuf[StreamAddr] << 8) | MemBuf[(WORD)(StreamAddr + 1)]);
+    StreamAddr += (WORD) 2;
+#else
     X = ReadStream51();
     X = (WORD)((X << 8) | ReadStream51());
+#endif
 
     return(X);
 }
@@ -175,9 +305,16 @@ WORD ReadStreamWord(void)
 long ReadStreamLong(void)
 {
     UVAL_DATA dat;
+#ifndef FLAT_MEMORY
     BYTE b;
+#endif
 
+#ifdef FLAT_MEMORY
+    memcpy(&dat, &MemBuf[StreamAddr], sizeof(dat));
+    StreamAddr += (WORD) sizeof(dat);
+#else
     for (b = 0; b != 4; b++) dat.bVal[b] = ReadStream51();
+#endif
 
     return(dat.LVal);
 }
@@ -193,24 +330,36 @@ float ReadStreamFloat(void)
 
 void StreamSkip(BYTE BytesToSkip)
 {
+#ifdef FLAT_MEMORY
+    StreamAddr += BytesToSkip;
+#else
 	SetStream51((WORD)(GetStreamAddr() + BytesToSkip));
+#endif
 }
 
 // Reads RAM byte.
 BYTE ReadRandom51(WORD addr)
 {
+#ifdef FLAT_MEMORY
+    return(MemBuf[addr]);
+#else
     BYTE dest;
 
 	ReadBlock51(&dest, addr, 1);
 
     return(dest);
+#endif
 }
 
 
 // Read Random Word
 WORD ReadRandomWord(WORD addr)
 {
+#ifdef FLAT_MEMORY
+    return((WORD)((MemBuf[addr] << 8) | MemBuf[(WORD)(addr + 1)]));
+#else
     return((WORD)((ReadRandom51(addr) << 8) | ReadRandom51((WORD)(addr + 1))));
+#endif
 }
 
 // Read Random DWORD
@@ -218,7 +367,11 @@ long ReadRandomLong(WORD addr)
 {
     long dat;
 
+#ifdef FLAT_MEMORY
+    memcpy(&dat, &MemBuf[addr], sizeof(UVAL_DATA));
+#else
     ReadBlock51((BYTE *) &dat, addr, sizeof(UVAL_DATA));
+#endif
 
     return(dat);
 }
@@ -227,22 +380,33 @@ long ReadRandomLong(WORD addr)
 // Write RAM byte
 void WriteRandom51(WORD addr, BYTE data)
 {
+#ifdef FLAT_MEMORY
+    MemBuf[addr] = data;
+#else
 	WriteBlock51(addr, &data, 1);
+#endif
 }
 
 // Write Random Word
 void WriteRandomWord(WORD addr, WORD val)
 {
+#ifdef FLAT_MEMORY
+    MemBuf[addr] = (BYTE)(val >> 8);
+    MemBuf[(WORD)(addr + 1)] = (BYTE)(val & 0xFF);
+#else
     WriteRandom51(addr, (BYTE)(val >> 8));        // high byte first
     WriteRandom51((WORD)(addr + 1), (BYTE)(val & 0xFF));  // Then low byte
+#endif
 }
 
 // Write Random Long
 void WriteRandomLong(WORD addr, long val)
 {
+#ifdef FLAT_MEMORY
+    memcpy(&MemBuf[addr], &val, sizeof(UVAL_DATA));
+#else
 	WriteBlock51(addr, (BYTE *) &val, sizeof(UVAL_DATA));
-    if (addr < BasicVars.VarStart ||
-        addr >= BasicVars.CmdLine) StreamDirtyFlag = TRUE;
+#endif
 }
 
 
@@ -251,11 +415,17 @@ void WriteRandomLong(WORD addr, long val)
 // hardware specific memmove()
 void MemMove51(WORD dest, WORD src, WORD Len)
 {
+#ifndef FLAT_MEMORY
     WORD Len2;
     BYTE Temp[64];
+#endif
 
     if (Len == 0 || dest == src)	return;	 // all done
+    STAT_ADD(STAT_BYTES_MOVED, Len);
 
+#ifdef FLAT_MEMORY
+    memmove(&MemBuf[dest], &MemBuf[src], Len);
+#else
     if (dest < src)   // Copy Forwards
     {
         while (Len)
@@ -300,7 +470,7 @@ void MemMove51(WORD dest, WORD src, WORD Len)
 
         }
     }
-
+#endif
 }
 
 
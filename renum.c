@@ -29,6 +29,12 @@ RENUM.C - Handles the RENUM command.
 */
 
 #include "bas51.h"
+#include "ext_tokens.h"
+
+void InvalidateLineIndex(void);   // editor.c
+void UnlinkProgram(void);         // flow_cmds.c
+void ClearExprCache(void);        // expression.c
+void ClearVMCache(void);          // command.c
 
 #define OnFlag uHash.b[0]
 
@@ -155,7 +161,18 @@ WORD RenumScan(void)
             case TOKEN_ELSE:   // special case - skip jump bytes
                 LineNumFlag = TRUE;   // possible line number token next
             case TOKEN_IF:
-				ReadStream51();    // Skip jump pointer
+				if (ReadStream51() == BLOCK_ELSE)    // Skip jump pointer
+                {
+                    StreamSkip(4);   // and the link of a block ELSE
+                    LineNumFlag = FALSE;
+                }
+                break;
+
+            case TOKEN_BEGIN:
+            case TOKEN_WHILE:
+            case TOKEN_CASE:
+                StreamSkip(4);   // skip block IF, loop or CASE link
+                LineNumFlag = FALSE;
                 break;
 
             case TOKEN_ON:
@@ -198,6 +215,8 @@ BIT DoRenumCmd(void)
     if (wArg[2] == 0xFFFF) wArg[2] = 10;  // default increment
     if (wArg[1] < wArg[0]) return(TRUE);  // New start line must be >= Old Start Line
 
+    UnlinkProgram();   // RenumScan() needs plain line numbers
+
     // Renumber algorithm
     // Start at the beginning of the program file.
 
@@ -218,6 +237,9 @@ BIT DoRenumCmd(void)
     // When all lines have been converted to new line numbers, traverse
     // program file again and set the line numbers to the new values.
     RenumHelper(0xFFFF);
+    InvalidateLineIndex();
+    ClearExprCache();
+    ClearVMCache();
 
 
     return(FALSE);
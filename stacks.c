@@ -29,6 +29,12 @@ STACKS.C - Stack management for the interpreter.
 */
 
 #include "bas51.h"
+#include "ext_tokens.h"
+#include "stats.h"
+
+BYTE ForKind(FOR_DESCRIPTOR *f);     // flow_cmds.c
+extern BYTE gForKind;                // flow_cmds.c
+extern WORD gForTop;                 // flow_cmds.c
 
 
 //#define CalcStack InBuf     // share with InBuf[]
@@ -81,6 +87,7 @@ void PushStk(BYTE Stack, BYTE Token)
     }
 
     StackTops[Stack]++;
+    STAT_MAX(STAT_STACK_MAX + Stack, StackTops[Stack] + 1);
 
     // special case for calculator stack
     if (Stack == CALC_STACK)
@@ -174,7 +181,177 @@ BYTE PeekStk(BYTE Stack)
 // the FOR_LOOP structures.
 // =========================================
 
+
+// HOST CONTROL STACK
+// The Win32 and POSIX versions keep a copy of every FOR_GOSUB frame in
+// CtlStack[], so SearchFor() does not have to walk the stack in RAM reading
+// tokens and hashes.  CtlGosub is the innermost GOSUB frame and CtlBucket[]
+// holds the innermost FOR frame for each group of variable hashes, each
+// frame linking to the next older one of its kind.  A NEXT or RETURN then
+// finds its frame in a step or two and takes the FOR or GOSUB structure from
+// the copy.  The frames in RAM are still written, since SNAPSHOT and the
+// memory count use them, and CtlStack[] is rebuilt from them whenever the
+// two fall out of step.  Frame offsets are from GosubStackBot, so moving the
+// stack when arrays are made does not affect them.
+
+#ifndef __C51__
+
+#define CTL_STACK_SIZE  (0x10000 / (sizeof(GOSUB_RETURN) + 1) + 1)  // all RAM
+#define CTL_BUCKETS     64           // must be a power of 2
+
+typedef struct
+{
+    BYTE Token;        // TOKEN_FOR, TOKEN_GOSUB, TOKEN_WHILE or TOKEN_DO
+    BYTE Kind;         // FOR loop kind, see ForKind()
+    WORD Ofs;          // Offset of the frame's token from GosubStackBot
+    WORD Prev;         // Next older frame of the same kind + 1, 0 = none
+    union
+    {
+        FOR_DESCRIPTOR For;
+        GOSUB_RETURN Gosub;
+    } u;
+} CTL_FRAME;
+
+CTL_FRAME CtlStack[CTL_STACK_SIZE];
+WORD CtlCount;                 // Frames in CtlStack[]
+WORD CtlTopOfs;                // GosubStackTop - GosubStackBot it matches
+WORD CtlGosub;                 // Innermost GOSUB frame + 1, 0 = none
+WORD CtlBucket[CTL_BUCKETS];   // Innermost FOR frame + 1 by hash, 0 = none
+WORD CtlFound;                 // Frame last returned by SearchFor()
+BIT CtlValid;
+
+
+static BYTE CtlBucketOf(DWORD Hash)
+{
+    return((BYTE)((Hash ^ (Hash >> 8) ^ (Hash >> 16) ^ (Hash >> 24)) &
+                  (CTL_BUCKETS - 1)));
+}
+
+
+// Make frame i the innermost of its kind.
+
+static void CtlLink(WORD i)
+{
+    WORD *Head;
+
+    if (CtlStack[i].Token == TOKEN_GOSUB) Head = &CtlGosub;
+    else if (CtlStack[i].Token == TOKEN_FOR)
+        Head = &CtlBucket[CtlBucketOf(CtlStack[i].u.For.Hash.d)];
+    else return;   // WHILE and DO frames are only looked for from the top
+
+    CtlStack[i].Prev = *Head;
+    *Head = (WORD)(i + 1);
+}
+
+
+// Drop frames from the top until Count are left.
+
+static void CtlChop(WORD Count)
+{
+    CTL_FRAME *f;
+
+    while (CtlCount > Count)
+    {
+        f = &CtlStack[--CtlCount];
+        if (f->Token == TOKEN_GOSUB) CtlGosub = f->Prev;
+        else if (f->Token == TOKEN_FOR)
+            CtlBucket[CtlBucketOf(f->u.For.Hash.d)] = f->Prev;
+    }
+    CtlTopOfs = (WORD)(BasicVars.GosubStackTop - BasicVars.GosubStackBot);
+}
+
+
+// Link every frame again from the bottom up.
+
+static void CtlRelink(void)
+{
+    WORD i;
+
+    CtlGosub = 0;
+    memset(CtlBucket, 0, sizeof(CtlBucket));
+    for (i = 0; i != CtlCount; i++) CtlLink(i);
+}
+
+
+// Make sure CtlStack[] matches the stack in RAM, reading it in again if not.
+
+static void CtlSync(void)
+{
+    WORD ptr, i, n;
+    BYTE Len;
+    CTL_FRAME Tmp;
+
+    if (CtlValid &&
+        CtlTopOfs == (WORD)(BasicVars.GosubStackTop - BasicVars.GosubStackBot))
+        return;
+
+    // Walk down from the top, which gives the frames newest first
+    n = 0;
+    ptr = BasicVars.GosubStackTop;
+    while (ptr > BasicVars.GosubStackBot && n != CTL_STACK_SIZE)
+    {
+        ptr--;
+        CtlStack[n].Token = ReadRandom51(ptr);
+        if (CtlStack[n].Token == TOKEN_FOR) Len = sizeof(FOR_DESCRIPTOR);
+        else Len = sizeof(GOSUB_RETURN);
+        CtlStack[n].Ofs = (WORD)(ptr - BasicVars.GosubStackBot);
+        ReadBlock51((BYTE *) &CtlStack[n].u, (WORD)(ptr - Len), Len);
+        if (CtlStack[n].Token == TOKEN_FOR)
+            CtlStack[n].Kind = ForKind(&CtlStack[n].u.For);
+        ptr -= Len;
+        n++;
+    }
+
+    // then turn them over
+    for (i = 0; i < n / 2; i++)
+    {
+        Tmp = CtlStack[i];
+        CtlStack[i] = CtlStack[n - 1 - i];
+        CtlStack[n - 1 - i] = Tmp;
+    }
+
+    CtlCount = n;
+    CtlRelink();
+    CtlTopOfs = (WORD)(BasicVars.GosubStackTop - BasicVars.GosubStackBot);
+    CtlValid = TRUE;
+}
+
+
+// Host version of SearchFor() below.
+
+WORD SearchFor(void)
+{
+    WORD i;
+
+    CtlSync();
+    if (CtlCount == 0) return(NULL);
+
+    if (uHash.d == 0)    // any FOR, so the top one that is not a loop
+    {
+        for (i = CtlCount; i && CtlStack[i - 1].Token != TOKEN_FOR &&
+             CtlStack[i - 1].Token != TOKEN_GOSUB; i--);
+        if (i == 0) return(NULL);
+    }
+    else
+    {
+        // Only FOR frames above the innermost GOSUB can match
+        i = CtlBucket[CtlBucketOf(uHash.d)];
+        while (i > CtlGosub && CtlStack[i - 1].u.For.Hash.d != uHash.d)
+            i = CtlStack[i - 1].Prev;
+        if (i <= CtlGosub) i = CtlGosub;
+        if (i == 0) return(NULL);
+    }
+
+    CtlFound = (WORD)(i - 1);
+    TmpChar = CtlStack[CtlFound].Token;
+    return((WORD)(BasicVars.GosubStackBot + CtlStack[CtlFound].Ofs));
+}
+
+#else
+
+
 // Search the FOR_GOSUB stack for the FOR struct that uses value in uHash.
+// WHILE and DO frames are passed over.
 // Return NULL if stack searched all the way to the bottom and not found.
 // Return pointer to FOR token and gFor set if found
 // or pointer to GOSUB token if not found.
@@ -191,7 +368,13 @@ WORD SearchFor(void)
     while (ptr >= BasicVars.GosubStackBot)
     {
         TmpChar = ReadRandom51(ptr);   // Read Token Type
-        if (TmpChar == TOKEN_GOSUB || uHash.d == 0) return(ptr);
+        if (TmpChar == TOKEN_GOSUB) return(ptr);
+        if (TmpChar != TOKEN_FOR)   // WHILE or DO loop, look past it
+        {
+            ptr -= (WORD)(sizeof(GOSUB_RETURN) + 1);
+            continue;
+        }
+        if (uHash.d == 0) return(ptr);
 
         // must be a FOR
         ptr -= (WORD) sizeof(FOR_DESCRIPTOR);   // point to variable pointer
@@ -208,10 +391,99 @@ WORD SearchFor(void)
     return(NULL);  // not in stack
 }
 
+#endif
+
+
+// Called when the stack in RAM was replaced by RESTORE SNAPSHOT.
+
+void InvalidateCtlStack(void)
+{
+#ifndef __C51__
+    CtlValid = FALSE;
+#endif
+    gFor.CtrlVarPtr = 0;    // may not be the loop on top any more
+}
+
+
+// Take the frame whose token is at ptr, with a structure of Len bytes, out
+// of the middle of the stack.  On hosts CtlFound must be the frame.
+
+static void DropFrame(WORD ptr, BYTE Len)
+{
+    WORD clen;
+
+    clen = (WORD)(BasicVars.GosubStackTop - ptr);
+    MemMove51((WORD)(ptr - Len), (WORD)(ptr + 1), clen);
+    BasicVars.GosubStackTop -= (WORD)(Len + 1);  // chop stack
+#ifndef __C51__
+    // Take the frame out of the copy too.  From the top that is
+    // just a chop, otherwise the frames above it move down.
+    if (CtlFound == CtlCount - 1) CtlChop(CtlFound);
+    else
+    {
+        memmove(&CtlStack[CtlFound], &CtlStack[CtlFound + 1],
+                (CtlCount - CtlFound - 1) * sizeof(CTL_FRAME));
+        for (clen = CtlFound; clen != CtlCount - 1; clen++)
+            CtlStack[clen].Ofs -= (WORD)(Len + 1);
+        CtlCount--;
+        CtlRelink();
+        CtlTopOfs = (WORD)(BasicVars.GosubStackTop - BasicVars.GosubStackBot);
+    }
+#endif
+}
+
+
+// Find the WHILE or DO frame of type Token for the loop that goes back to
+// gReturn.ReturnPtr, above the innermost GOSUB.  Returns the address of its
+// token, with CtlFound set on hosts, or NULL if it isn't there.
+
+static WORD SearchLoop(BYTE Token)
+{
+#ifndef __C51__
+    WORD i;
+
+    CtlSync();
+    for (i = CtlCount; i && CtlStack[i - 1].Token != TOKEN_GOSUB; i--)
+    {
+        if (CtlStack[i - 1].Token == Token &&
+            CtlStack[i - 1].u.Gosub.ReturnPtr == gReturn.ReturnPtr)
+        {
+            CtlFound = (WORD)(i - 1);
+            return((WORD)(BasicVars.GosubStackBot + CtlStack[i - 1].Ofs));
+        }
+    }
+#else
+    WORD ptr;
+    GOSUB_RETURN Loop;
+
+    ptr = BasicVars.GosubStackTop;
+    while (ptr > BasicVars.GosubStackBot)
+    {
+        TmpChar = ReadRandom51(--ptr);
+        if (TmpChar == TOKEN_GOSUB) break;
+
+        if (TmpChar == TOKEN_FOR)
+        {
+            ptr -= (WORD) sizeof(FOR_DESCRIPTOR);
+            continue;
+        }
+
+        ReadBlock51((BYTE *) &Loop, (WORD)(ptr - sizeof(GOSUB_RETURN)),
+            sizeof(GOSUB_RETURN));
+        if (TmpChar == Token && Loop.ReturnPtr == gReturn.ReturnPtr)
+            return(ptr);
+        ptr -= (WORD) sizeof(GOSUB_RETURN);
+    }
+#endif
+
+    return(NULL);
+}
+
 
 // Push a structure on the FOR_GOSUB stack.
-// This is called by GOSUB and FOR statements.
+// This is called by GOSUB, FOR, WHILE and DO statements.
 // The FOR structure is contained in gFor and the GOSUB structure is in gReturn.
+// WHILE and DO push a GOSUB structure too, holding the address to loop to.
 //
 // When pushing a GOSUB structure, the return address is the actual address
 // of the next command token.  If the GOSUB command is being executed directly
@@ -227,6 +499,9 @@ WORD SearchFor(void)
 // If the FOR structure is not already there that uses the same variable, a
 // new FOR_STRUCTURE is pushed followed by a TOKEN_FOR.
 //
+// WHILE and DO do the same with a frame for the same loop, left behind by
+// a GOTO out of it, so going round that way doesn't use up the stack.
+//
 // Return TRUE if not enough memory.  Clears the Temp string Stack.
 
 BIT PushStruct(BYTE Token)
@@ -238,6 +513,9 @@ BIT PushStruct(BYTE Token)
     // Defaults for Gosub
     Len = sizeof(GOSUB_RETURN);
     StructPtr = (BYTE *) &gReturn;
+#ifndef __C51__
+    CtlSync();
+#endif
 
     if (Token == TOKEN_FOR)   // special code for FOR structures
     {
@@ -252,17 +530,20 @@ BIT PushStruct(BYTE Token)
         ptr = SearchFor();
         if (ptr != NULL && TmpChar == TOKEN_FOR)  // is it already there?
         {
-            WORD clen;
-
             // The for lop structure was already there
             // delete it and compress stack
-            clen = (WORD)(BasicVars.GosubStackTop - ptr);
-            MemMove51((WORD)(ptr - sizeof(FOR_DESCRIPTOR)), (WORD)(ptr + 1), clen);
-            BasicVars.GosubStackTop -= (WORD)(sizeof(FOR_DESCRIPTOR) + 1);  // chop stack
-//            goto CopyStruct;
+            DropFrame(ptr, sizeof(FOR_DESCRIPTOR));
         }
 
     }
+    else if (Token == TOKEN_WHILE || Token == TOKEN_DO)
+    {
+        WORD ptr;
+
+        // The same loop started again after a GOTO out of it
+        ptr = SearchLoop(Token);
+        if (ptr != NULL) DropFrame(ptr, sizeof(GOSUB_RETURN));
+    }
 
     TmpPtr = BasicVars.GosubStackTop;    // Save original stack top
 
@@ -281,6 +562,14 @@ BIT PushStruct(BYTE Token)
     WriteRandom51((WORD)(TmpPtr + Len), Token);
 //CopyStruct:
     WriteBlock51(TmpPtr, StructPtr, Len);
+#ifndef __C51__
+    CtlStack[CtlCount].Token = Token;
+    CtlStack[CtlCount].Kind = gForKind;
+    CtlStack[CtlCount].Ofs = (WORD)(TmpPtr + Len - BasicVars.GosubStackBot);
+    memcpy(&CtlStack[CtlCount].u, StructPtr, Len);
+    CtlLink(CtlCount++);
+    CtlTopOfs = (WORD)(BasicVars.GosubStackTop - BasicVars.GosubStackBot);
+#endif
 	FreeTempAlloc();   // reset the temp strings
 
     return(FALSE);
@@ -290,8 +579,8 @@ BIT PushStruct(BYTE Token)
 // If the stack was empty, return NULL, else return RETURN address.
 // The return address should point to the token immediately after the GOSUB
 // statement - ':' or '\r'.
-// Any FOR structures in the way are removed along with the GOSUB structure
-// itself.
+// Any FOR, WHILE or DO structures in the way are removed along with the
+// GOSUB structure itself.
 
 WORD PopGosub(void)
 {
@@ -312,13 +601,74 @@ WORD PopGosub(void)
     BasicVars.GosubStackTop = ptr;
 
     // Read Structure
+#ifndef __C51__
+    gReturn = CtlStack[CtlFound].u.Gosub;
+    CtlChop(CtlFound);
+#else
     ReadBlock51((BYTE *) &gReturn, ptr, sizeof(GOSUB_RETURN));
+#endif
     
     return(gReturn.ReturnPtr);   // Return Line pointer
 }
 
 
 
+// Get the innermost WHILE or DO frame of type Token into gReturn.  It must
+// be above the innermost GOSUB.  Anything above it, FOR loops or loops that
+// were left with a GOTO, is chopped off the stack.
+// Returns TRUE if not found.
+
+BIT GetLoop(BYTE Token)
+{
+#ifndef __C51__
+    WORD i;
+
+    CtlSync();
+    for (i = CtlCount; i && CtlStack[i - 1].Token != Token; i--)
+        if (CtlStack[i - 1].Token == TOKEN_GOSUB) return(TRUE);
+    if (i == 0) return(TRUE);
+
+    gReturn = CtlStack[i - 1].u.Gosub;
+    BasicVars.GosubStackTop =   // chop stack
+        (WORD)(BasicVars.GosubStackBot + CtlStack[i - 1].Ofs + 1);
+    CtlChop(i);
+#else
+    WORD ptr;
+
+    ptr = BasicVars.GosubStackTop;
+    while (ptr > BasicVars.GosubStackBot)
+    {
+        TmpChar = ReadRandom51(--ptr);
+        if (TmpChar == Token)
+        {
+            BasicVars.GosubStackTop = (WORD)(ptr + 1);  // chop stack
+            ReadBlock51((BYTE *) &gReturn, (WORD)(ptr - sizeof(GOSUB_RETURN)),
+                sizeof(GOSUB_RETURN));
+            return(FALSE);
+        }
+        if (TmpChar == TOKEN_GOSUB) break;
+
+        if (TmpChar == TOKEN_FOR) ptr -= (WORD) sizeof(FOR_DESCRIPTOR);
+        else ptr -= (WORD) sizeof(GOSUB_RETURN);
+    }
+    return(TRUE);
+#endif
+
+    return(FALSE);
+}
+
+
+// Drop the WHILE or DO frame that GetLoop() left on top when its loop ends.
+
+void PopLoop(void)
+{
+    BasicVars.GosubStackTop -= (WORD)(sizeof(GOSUB_RETURN) + 1);
+#ifndef __C51__
+    CtlChop((WORD)(CtlCount - 1));
+#endif
+}
+
+
 // Get FOR DESCRIPTOR for specified variable into gFor.
 // Searches for matching variable uHash.
 // If uHash is zero, return first FOR found.
@@ -339,17 +689,36 @@ BIT GetFor(void)
 
     // We found the FOR struct we were looking for if here
     BasicVars.GosubStackTop = (WORD)(addr + 1);  // chop stack
+    gForTop = BasicVars.GosubStackTop;
 
+#ifndef __C51__
+    gFor = CtlStack[CtlFound].u.For;
+    gForKind = CtlStack[CtlFound].Kind;
+    CtlChop((WORD)(CtlFound + 1));
+#else
     if (gFor.CtrlVarPtr == 0 || gFor.Hash.d != uHash.d)
     {
         // Its different from the one we have so read new one in
         addr -= (WORD) sizeof(FOR_DESCRIPTOR);  // point to base
         ReadBlock51((BYTE *) &gFor, addr, sizeof(FOR_DESCRIPTOR));
+        gForKind = ForKind(&gFor);
     }
+#endif
 
     return(FALSE);
 }
 
 
+// Drop the FOR frame on top of the stack when its loop ends.
+
+void PopFor(void)
+{
+    BasicVars.GosubStackTop -= (WORD)(sizeof(FOR_DESCRIPTOR) + 1);
+#ifndef __C51__
+    CtlChop((WORD)(CtlCount - 1));
+#endif
+}
+
+
 
 
@@ -0,0 +1,70 @@
+/*
+This source file is part of the TRS-8051 project.  BAS51 is a work alike
+rewrite of the Microsoft Level 2 BASIC for the TRS-80 that is intended to run
+on an 8051 microprocessor.  This version is in intended to also run under
+Windows for testing purposes.
+
+Copyright (C) 2017  Dennis Hawkins
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+If you use this code in any way, I would love to hear from you.  My email
+address is: dennis@galliform.com
+*/
+
+/*
+STATS.H - Counters for the interpreter's hot paths.  STATS prints them and
+STATS RESET clears them.  The STAT_xxx() macros compile to nothing in the
+8051 version, so the counters cost nothing there.
+*/
+
+#ifndef STATS_H
+#define STATS_H
+
+enum
+{
+    STAT_STATEMENTS,         // statements run by ExecuteLine()
+    STAT_FIND_LINE,          // FindLinePtr() calls
+    STAT_LINES_SCANNED,      // lines walked by FindLinePtr()
+    STAT_VAR_LOOKUPS,        // GetVarPtr() calls
+    STAT_VAR_PROBES,         // index slots and variables looked at
+    STAT_STREAM_HITS,        // SetStream51() found the line in the cache
+    STAT_STREAM_REFILLS,     // SetStream51() had to read the line
+    STAT_BYTES_MOVED,        // bytes moved by MemMove51()
+    STAT_STR_ALLOC,          // StringAlloc() calls
+    STAT_STR_FREE,           // FreeStringAlloc() calls
+    STAT_STR_REALLOC,        // ReStringAlloc() calls
+    STAT_FREE_LIST_HITS,     // buffers reused from a free list
+    STAT_STACK_MAX,          // PushStk() high water, one per stack:
+    STAT_COUNT = STAT_STACK_MAX + 4   // CALC, OPERATOR, ARG and PARM
+};
+
+#ifdef __C51__
+
+#define STAT_INC(n)
+#define STAT_ADD(n, v)
+#define STAT_MAX(n, v)
+
+#else
+
+extern DWORD Stats[STAT_COUNT];      // globals.c
+
+#define STAT_INC(n)      (Stats[n]++)
+#define STAT_ADD(n, v)   (Stats[n] += (DWORD)(v))
+#define STAT_MAX(n, v)   ((DWORD)(v) > Stats[n] ? (Stats[n] = (DWORD)(v)) : 0)
+
+#endif
+
+#endif
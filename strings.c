@@ -30,6 +30,7 @@ STRINGS.C - String allocation routines.
 
 
 #include "Bas51.h"
+#include "stats.h"
 
 // =========================================
 // Temporary String stack
@@ -200,9 +201,11 @@ WORD StringAlloc(BYTE BlkCnt)
 {
     WORD ptr;
 
+    STAT_INC(STAT_STR_ALLOC);
     ptr = BasicVars.FreeList[BlkCnt];
     if (ptr)  // We found a suitable free buffer
     {
+        STAT_INC(STAT_FREE_LIST_HITS);
         PopFree(BlkCnt);   // remove free buffer from free list
         ptr++;
     }
@@ -236,6 +239,7 @@ void FreeStringAlloc(WORD BufPtr)
 {
     BYTE BlkCnt;
 
+    STAT_INC(STAT_STR_FREE);
     if (BufPtr == NULL) return;      // check NULL
     BufPtr--;                        // point to control byte
     // Check bounds
@@ -275,6 +279,8 @@ WORD ReStringAlloc(WORD BufPtr, BYTE BufLen)
 {
     BYTE NewBlks, BlkCnt;
 
+    STAT_INC(STAT_STR_REALLOC);
+
     // Function must return NULL if BufLen is zero.
     if (BufLen == 0)
     {
@@ -304,6 +310,7 @@ WORD ReStringAlloc(WORD BufPtr, BYTE BufLen)
         if (BasicVars.FreeList[NewBlks] > BufPtr)
 	    {
             // Move to higher spot
+            STAT_INC(STAT_FREE_LIST_HITS);
     	    FreeStringAlloc(BufPtr);   // free old buffer
         	BufPtr = (WORD)(BasicVars.FreeList[NewBlks] + 1);
 	        PopFree(NewBlks);
@@ -32,6 +32,9 @@ TOKENIZER.C - Routines to tokenize and de-tokenize BASIC source lines.
 
 
 #include "Bas51.h"
+#include "ext_tokens.h"
+
+void UnlinkProgram(void);   // flow_cmds.c
 
 
 /*
@@ -108,6 +111,119 @@ BYTE MatchTokenTable(BYTE *Table)
 }
 
 
+// The names in ExtTokenTable[] were free for variables before, so one of
+// them only counts when the character after it can't carry on a name.
+// DONE, LOOPS and WHILEX are still variables.  Return TRUE if c can.
+
+BIT NameContinues(BYTE c)
+{
+    return((BIT)(isalnum(c) || c == '$' || c == '%' || c == '!' || c == '#'));
+}
+
+
+// KEYWORD TRIE
+// MatchToken() used to try every entry of all three token tables at each
+// position in the line.  On hosts the tables are now loaded into a trie
+// the first time a line is tokenized, so a keyword is found in one pass
+// over its characters.  A keyword matches whenever its name is a prefix of
+// the input, and the one that comes first in the tables wins, which is why
+// the tables list longer names first.  So every node where a name ends
+// remembers that name's position in the tables, and the lookup keeps the
+// earliest one passed on the way down.  If the tables ever outgrow the
+// trie, MatchToken() goes back to searching the tables.
+
+#ifndef __C51__
+
+#define KEY_TRIE_SIZE   1024
+
+BYTE KeyChar[KEY_TRIE_SIZE];     // Character leading to this node
+WORD KeyChild[KEY_TRIE_SIZE];    // First child, 0 = none
+WORD KeyNext[KEY_TRIE_SIZE];     // Next sibling, 0 = none
+BYTE KeyToken[KEY_TRIE_SIZE];    // Token of name ending here, or 0xFF
+WORD KeyOrder[KEY_TRIE_SIZE];    // Position of that name in the tables
+WORD KeyRoot[256];               // Node for each first character
+WORD KeyNodes;                   // Nodes in use, node 0 is never used
+WORD KeyNames;                   // Names added so far
+BYTE KeyTrieState;               // 0 = not built, 1 = built, 2 = too big
+
+
+// Add every name in a token table to the trie.
+// Base is the token number of the first name.
+// Return TRUE if the trie is full.
+
+BIT AddKeyTable(BYTE *Table, BYTE Base)
+{
+    WORD n, c;
+    BYTE ch;
+
+    n = 0;
+    while (*Table != 0x80)      // 0x80 marks the end of the table
+    {
+        ch = (BYTE)(*Table & 0x7F);
+
+        if (*Table & 0x80)      // start of the next name
+        {
+            if (n) Base++;
+            n = KeyRoot[ch];
+            if (n == 0)
+            {
+                if (KeyNodes == KEY_TRIE_SIZE) return(TRUE);
+                n = KeyRoot[ch] = KeyNodes++;
+                KeyChar[n] = ch;
+            }
+        }
+        else   // next character of the name
+        {
+            for (c = KeyChild[n]; c && KeyChar[c] != ch; c = KeyNext[c]);
+            if (c == 0)
+            {
+                if (KeyNodes == KEY_TRIE_SIZE) return(TRUE);
+                c = KeyNodes++;
+                KeyChar[c] = ch;
+                KeyNext[c] = KeyChild[n];
+                KeyChild[n] = c;
+            }
+            n = c;
+        }
+
+        Table++;
+
+        // If the name ends here, the earlier duplicate wins
+        if ((*Table & 0x80) && KeyToken[n] == 0xFF)
+        {
+            KeyToken[n] = Base;
+            KeyOrder[n] = KeyNames;
+        }
+        if (*Table & 0x80) KeyNames++;
+    }
+
+    return(FALSE);
+}
+
+
+// Build the trie from the token tables, in the order MatchToken() used
+// to search them.
+
+void BuildKeyTrie(void)
+{
+    memset(KeyRoot, 0, sizeof(KeyRoot));
+    memset(KeyChild, 0, sizeof(KeyChild));
+    memset(KeyToken, 0xFF, sizeof(KeyToken));
+    KeyNodes = 1;
+    KeyNames = 0;
+    KeyTrieState = 2;
+
+    if (AddKeyTable(ExtTokenTable, EXT_TOKEN_START)) return;
+    if (AddKeyTable(OperatorTokenTable, OPERATOR_TOKEN_START)) return;
+    if (AddKeyTable(CommandTokenTable, COMMAND_TOKEN_START)) return;
+    if (AddKeyTable(FunctionTokenTable, FUNCTION_TOKEN_START)) return;
+
+    KeyTrieState = 1;
+}
+
+#endif
+
+
 // Search all token tables for token pointed to by InBufPtr.
 // Assumes leading blanks already skipped.
 // Returns actual Token number, or 0 if not found.
@@ -116,6 +232,46 @@ BYTE MatchTokenTable(BYTE *Table)
 BYTE MatchToken(void)
 {
     BYTE r;
+    BYTE *Start;
+
+#ifndef __C51__
+    if (KeyTrieState == 0) BuildKeyTrie();
+    if (KeyTrieState == 1)
+    {
+        WORD n, Order;
+        BYTE b, Len, ch;
+
+        r = 0xFF;
+        Order = 0xFFFF;
+        Len = 0;
+        n = KeyRoot[(BYTE) toupper(InBufPtr[0])];
+        for (b = 1; n; b++)
+        {
+            if (KeyToken[n] != 0xFF && KeyOrder[n] < Order &&
+                (KeyToken[n] >= LAST_EXT_TOKEN ||
+                 !NameContinues(InBufPtr[b])))
+            {
+                r = KeyToken[n];
+                Order = KeyOrder[n];
+                Len = b;
+            }
+
+            ch = (BYTE) toupper(InBufPtr[b]);
+            for (n = KeyChild[n]; n && KeyChar[n] != ch; n = KeyNext[n]);
+        }
+
+        InBufPtr += Len;
+        return(r);
+    }
+#endif
+
+    Start = InBufPtr;
+    r = MatchTokenTable(ExtTokenTable);
+    if (r != 0xFF)
+    {
+        if (!NameContinues(*InBufPtr)) return((BYTE)(EXT_TOKEN_START + r));
+        InBufPtr = Start;    // part of a longer name
+    }
 
     r = MatchTokenTable(OperatorTokenTable);
     if (r != 0xFF) return((BYTE)(OPERATOR_TOKEN_START + r));
@@ -198,6 +354,8 @@ BYTE TokenizeLine(BYTE *Buffer, BYTE BufLen)
     BYTE LineLen;
     BYTE Parenthesis;
     BYTE IfPtr;
+    BYTE IfCount;
+    BIT BlockElse;
     BYTE ret;
 
     ret = 0;
@@ -208,6 +366,7 @@ BYTE TokenizeLine(BYTE *Buffer, BYTE BufLen)
     TokBufPtr = TokBuf;
     LastToken = 0xFF;
     IfPtr = 0;
+    IfCount = 0;   // single line IF's so far
 
     // Check for leading line number
     CurChar = SkipBlanks();   // skip blanks and set CurChar
@@ -247,6 +406,7 @@ BYTE TokenizeLine(BYTE *Buffer, BYTE BufLen)
         {
             // handle abbreviations
             if (r == TOKEN_PRINT2) r = TOKEN_PRINT;
+            if (r == TOKEN_WHILE && LastToken == TOKEN_LOOP) r = TOKEN_LOOP_WHILE;
 //            if (r == TOKEN_REM2) r = TOKEN_REM;
             if (r == TOKEN_LEFT_PAREN) Parenthesis++;
             if (r == TOKEN_RIGHT_PAREN) Parenthesis--;
@@ -287,10 +447,15 @@ BYTE TokenizeLine(BYTE *Buffer, BYTE BufLen)
                 }
             }
 
+            // An ELSE that starts a statement belongs to a block IF unless
+            // a single line IF came before it on this line
+            BlockElse = (BIT)(r == TOKEN_ELSE && IfCount == 0 &&
+                (LastToken == 0xFF || LastToken == TOKEN_COLON));
+
             *TokBufPtr++ = r;
             LineLen++;
 
-            StartOfStatement = (BIT)((r == TOKEN_COLON ||
+            StartOfStatement = (BIT)((r == TOKEN_COLON || r == TOKEN_BEGIN ||
             		r == TOKEN_THEN || r == TOKEN_ELSE) ? TRUE : FALSE);
             LastToken = r;
 
@@ -315,13 +480,47 @@ BYTE TokenizeLine(BYTE *Buffer, BYTE BufLen)
             // IF_TOKEN <offset to ELSE> ... ELSE_TOKEN <offset to EOL>
             // Create Linked list of IF-THEN tokens.
 
-            if (r == TOKEN_IF || r == TOKEN_ELSE)
+            if (r == TOKEN_IF || (r == TOKEN_ELSE && !BlockElse))
             {
                 *TokBufPtr++ = IfPtr;   // reserve space for jump size
                 IfPtr = (BYTE)(LineLen + 3);
                 LineLen++;
+                if (r == TOKEN_IF) IfCount++;
 			}
 
+            // special case for block IF
+            // IF <expression> BEGIN ... [ELSE ...] ENDIF
+            // BEGIN_TOKEN <link> ... ELSE_TOKEN BLOCK_ELSE <link> ... ENDIF
+            // The IF before BEGIN is taken back off the list of IF-ELSE's,
+            // its offset byte is not used.
+
+            else if (r == TOKEN_BEGIN || BlockElse)
+            {
+                if (BlockElse)
+                {
+                    *TokBufPtr++ = BLOCK_ELSE;
+                    LineLen++;
+                }
+                else if (IfPtr && TokBuf[IfPtr - 1] == TOKEN_IF)
+                {
+                    b = TokBuf[IfPtr];
+                    TokBuf[IfPtr] = 0;
+                    IfPtr = b;
+                    IfCount--;
+                }
+
+                TokBufPtr += 4;   // link, TokBuf[] starts out cleared
+                LineLen += (BYTE) 4;
+            }
+
+            // WHILE <link> <expression>, the link is to the end of the loop
+            // CASE <link> [<expression list> | ELSE], see SELECT CASE
+            else if (r == TOKEN_WHILE || r == TOKEN_CASE)
+            {
+                TokBufPtr += 4;
+                LineLen += (BYTE) 4;
+            }
+
         }
 
 //        // SPECIAL TERMINAL CHAR COLON
@@ -606,6 +805,13 @@ BYTE GetNextToken(void)
         case TOKEN_IF:
         case TOKEN_ELSE:
             uData.bVal[0] = ReadStream51();  // offset
+            if (uData.bVal[0] == BLOCK_ELSE) StreamSkip(4);   // and a link
+            break;
+
+        case TOKEN_BEGIN:
+        case TOKEN_WHILE:
+        case TOKEN_CASE:
+            StreamSkip(4);   // link
             break;
 
         default:
@@ -626,6 +832,7 @@ BIT PrintPreSpace(BYTE Token)
    // if (Token == TOKEN_GOTO || Token == TOKEN_GOSUB) return(TRUE);
     if (Token < TOKEN_SEMICOLON && Token != TOKEN_UNARY_MINUS) return(TRUE);
     if (Token >= COMMAND_TOKEN_START && Token < LAST_COMMAND_TOKEN) return(TRUE);
+    if (Token >= EXT_TOKEN_START && Token < LAST_EXT_TOKEN) return(TRUE);
     return(FALSE);
 }
 
@@ -635,6 +842,7 @@ BIT PrintPostSpace(BYTE Token)
     if (Token == TOKEN_LEFT_PAREN) return(FALSE);
     if (Token <= TOKEN_SEMICOLON && Token != TOKEN_UNARY_MINUS) return(TRUE);
     if (Token >= COMMAND_TOKEN_START && Token < LAST_COMMAND_TOKEN) return(TRUE);
+    if (Token >= EXT_TOKEN_START && Token < LAST_EXT_TOKEN) return(TRUE);
     return(FALSE);
 }
 
@@ -664,11 +872,14 @@ BYTE *GetTokenName(BYTE *TokenTable, BYTE Token)
 
 
 // Given the token number, return pointer to token string.
-// ASSUMES: Token is less than LAST_COMMAND_TOKEN.
+// ASSUMES: Token is less than LAST_COMMAND_TOKEN or an extended token.
 // Return NULL if not found.
 
 BYTE *GetTokenFromTable(BYTE Token)
 {
+    if (Token >= EXT_TOKEN_START && Token < LAST_EXT_TOKEN)
+        return(GetTokenName(ExtTokenTable, (BYTE)(Token - EXT_TOKEN_START)));
+
     if (Token >= COMMAND_TOKEN_START)
         return(GetTokenName(CommandTokenTable, (BYTE)(Token - COMMAND_TOKEN_START)));
 
@@ -684,6 +895,62 @@ BYTE *GetTokenFromTable(BYTE Token)
 
 
 
+// DETOKENIZER OUTPUT
+// PrintTokenizedLine() and PrintTokenFromTable() send their characters
+// through DetokPutc().  Normally that is the screen, but while SAVE is
+// running (DetokToFile set) they are collected in DetokBuf[] and written to
+// the open file a block at a time, so nothing is drawn and lines are not
+// limited by the screen width.
+
+#ifndef DETOK_BUF_SIZE
+#ifdef __C51__
+#define DETOK_BUF_SIZE  64
+#else
+#define DETOK_BUF_SIZE  1024
+#endif
+#endif
+
+XDATA BYTE DetokBuf[DETOK_BUF_SIZE];
+WORD DetokLen;
+BIT DetokToFile;
+BIT DetokError;        // a block was lost, kept until the next file listing
+
+BIT BasWriteBlock(BYTE *Buf, WORD Len);   // drivers.c
+
+
+// Write out whatever is in DetokBuf[].  Sets DetokError on error, since
+// PrintTokenFromTable() clears SyntaxErrorCode for the rest of the line.
+
+void FlushDetok(void)
+{
+    if (DetokLen && BasWriteBlock(DetokBuf, DetokLen))
+    {
+        SyntaxErrorCode = ERROR_FILE_IO;
+        DetokError = TRUE;
+    }
+    DetokLen = 0;
+}
+
+
+void DetokPutc(BYTE c)
+{
+    if (!DetokToFile)
+    {
+        VGA_putchar(c);
+        return;
+    }
+
+    if (DetokLen == sizeof(DetokBuf)) FlushDetok();
+    DetokBuf[DetokLen++] = c;
+}
+
+
+void DetokPrint(char *s)
+{
+    while (*s) DetokPutc((BYTE) *s++);
+}
+
+
 // Print Token at cursor location
 // Returns SyntaxErrorCode set on error.
 
@@ -699,11 +966,11 @@ void PrintTokenFromTable(BYTE Token)
     }
     else
     {
-    	VGA_putchar((BYTE)(*bp & 0x7F));
+    	DetokPutc((BYTE)(*bp & 0x7F));
     	bp++;
     	while (!(*bp & 0x80))
     	{
-        	VGA_putchar((BYTE)(*bp++));
+        	DetokPutc((BYTE)(*bp++));
     	}
     }
 
@@ -719,7 +986,9 @@ BYTE PrintTokenizedLine(WORD LinePtr)
 {
     BYTE CurToken;
     BIT LastCharWasSpace;
+    char Num[20];
 
+    UnlinkProgram();         // so line numbers print as line numbers
     SetStream51(LinePtr);    // must use memory file functions
     FieldStart = (WORD)(CurPosY * VID_COLS + CurPosX);
     FieldLen = 0;     // will be incremented by VGA_putchar()
@@ -730,7 +999,8 @@ BYTE PrintTokenizedLine(WORD LinePtr)
 
     	w = (WORD)(ReadStream51() << 8);
     	w |= ReadStream51();
-    	VGA_printf("%5u ", w);
+    	sprintf(Num, "%5u ", w);
+    	DetokPrint(Num);
         LastCharWasSpace = TRUE;
     	ReadStream51();   // Skip Length
     }
@@ -740,14 +1010,16 @@ BYTE PrintTokenizedLine(WORD LinePtr)
         // numerical float constants
         if (CurToken == TOKEN_FLOAT_CONST)
         {
-            VGA_printf("%G", ReadStreamFloat());
+            sprintf(Num, "%G", ReadStreamFloat());
+            DetokPrint(Num);
             LastCharWasSpace = FALSE;
         }
 
         // Numerical UINT constants
         else if (CurToken == TOKEN_INTL_CONST)
         {
-            VGA_printf("%d", ReadStreamLong());
+            sprintf(Num, "%d", ReadStreamLong());
+            DetokPrint(Num);
             LastCharWasSpace = FALSE;
         }
 
@@ -756,17 +1028,17 @@ BYTE PrintTokenizedLine(WORD LinePtr)
         {
             BYTE StringLen;
 
-            VGA_putchar('"');
+            DetokPutc('"');
             StringLen = ReadStream51();
             for (; StringLen; StringLen--)
-                VGA_putchar(ReadStream51());
-            VGA_putchar('"');
+                DetokPutc(ReadStream51());
+            DetokPutc('"');
             LastCharWasSpace = FALSE;
         }
 
         else if (CurToken == TOKEN_LABEL)
         {
-            VGA_print("UNKNOWN-LABEL");
+            DetokPrint("UNKNOWN-LABEL");
             StreamSkip(4);
         }
 
@@ -778,7 +1050,7 @@ BYTE PrintTokenizedLine(WORD LinePtr)
 
             // copy variable name
             for (; VarLen; VarLen--)
-                VGA_putchar(ReadStream51());
+                DetokPutc(ReadStream51());
 
             // skip past hash
             for (VarLen = 4; VarLen; VarLen--)
@@ -787,30 +1059,31 @@ BYTE PrintTokenizedLine(WORD LinePtr)
             // Add type modifier char
             if (CurToken == TOKEN_INTL_VAR || CurToken == TOKEN_INTL_ARRAY)
             {
-                VGA_putchar('%');
+                DetokPutc('%');
             }
 
             if (CurToken == TOKEN_FLOAT_VAR || CurToken == TOKEN_FLOAT_ARRAY)
             {
-                VGA_putchar('!');
+                DetokPutc('!');
             }
 
             if (CurToken == TOKEN_STRING_VAR || CurToken == TOKEN_STRING_ARRAY)
             {
-                VGA_putchar('$');
+                DetokPutc('$');
             }
 
             LastCharWasSpace = FALSE;
         }
 
-        else if (CurToken >= OPERATOR_TOKEN_START && CurToken < LAST_COMMAND_TOKEN)
+        else if ((CurToken >= OPERATOR_TOKEN_START && CurToken < LAST_COMMAND_TOKEN) ||
+                 (CurToken >= EXT_TOKEN_START && CurToken < LAST_EXT_TOKEN))
         {
-            if (!LastCharWasSpace && PrintPreSpace(CurToken)) VGA_putchar(' ');
+            if (!LastCharWasSpace && PrintPreSpace(CurToken)) DetokPutc(' ');
             PrintTokenFromTable(CurToken);
             if (SyntaxErrorCode) goto error;
             if (PrintPostSpace(CurToken))
             {
-                VGA_putchar(' ');
+                DetokPutc(' ');
                 LastCharWasSpace = TRUE;
             }
 
@@ -819,20 +1092,26 @@ BYTE PrintTokenizedLine(WORD LinePtr)
             if (CurToken == TOKEN_REM || CurToken == TOKEN_REM2)
             {
                 while ((CurToken = ReadStream51()) != '\r')
-                    VGA_putchar(CurToken);
+                    DetokPutc(CurToken);
                 break;   // we already found the \r
             }
 
             // special case for IF-ELSE
             if (CurToken == TOKEN_IF || CurToken == TOKEN_ELSE)
-                    ReadStream51();   // sync back up
+            {
+                if (ReadStream51() == BLOCK_ELSE)   // sync back up
+                    StreamSkip(4);
+            }
+            if (CurToken == TOKEN_BEGIN || CurToken == TOKEN_WHILE ||
+                CurToken == TOKEN_CASE)
+                StreamSkip(4);   // skip link
         }
 
 
 //        // Special case for Terminal Char COLON
 //        else if (CurToken == TOKEN_COLON)
 //        {
-//                VGA_print(" : ");
+//                DetokPrint(" : ");
 //                LastCharWasSpace = TRUE;
 //        }
 
@@ -858,7 +1137,8 @@ error:
 // If StartLine == 0, lists from beginning.
 // If StartLine > 0xFF00) Lists to end.
 // EndLine cannot be 0xFFFF.
-// If StartLine == 0xFFFF, entire file is being saved.
+// If StartLine == 0xFFFF, entire file is being saved to the open file.
+// SyntaxErrorCode is set if that fails.
 
 void ListProgram(WORD StartLine, WORD EndLine)
 {
@@ -886,33 +1166,27 @@ void ListProgram(WORD StartLine, WORD EndLine)
     if (EndLine == 0) EndLine = BasicVars.VarStart;
 
 
+    DetokToFile = SaveFlag;
+    DetokLen = 0;
+    DetokError = FALSE;
+
     while (StartLine < EndLine)
     {
-        FieldStart = (WORD) (CurPosY * 64 + CurPosX);  // Set FieldStart
-
         r = PrintTokenizedLine(StartLine);
         if (r != ERROR_NONE) break;
 
-        // calculate FieldLen
-        FieldLen = (BYTE)((CurPosY * 64 + CurPosX) - FieldStart);
-
-        // Don't print newline until length calculated.
-        VGA_putchar('\n');
-
-        // Special code to save file
         if (SaveFlag)
         {
-            while (FieldLen != 0)
-            {
-                BasWriteByte(VIDEO_MEMORY[FieldStart++]);
-                FieldLen--;
-            }
-            BasWriteByte('\n');
+            DetokPutc('\r');    // files keep DOS line endings
+            DetokPutc('\n');
         }
+        else VGA_putchar('\n');
 
         StartLine = GetStreamAddr();   // next line
     }
 
+    if (SaveFlag) FlushDetok();
+    DetokToFile = FALSE;
 }
 
 
@@ -30,6 +30,14 @@ VARS.C - Variable management.
 
 
 #include "bas51.h"
+#include "stats.h"
+
+void InvalidateLineIndex(void);   // editor.c
+void ClearExprCache(void);        // expression.c
+void ClearVMCache(void);          // command.c
+void ForgetLinks(void);           // flow_cmds.c
+
+void BumpVarGeneration(void);
 
 
 
@@ -41,6 +49,188 @@ VARS.C - Variable management.
 
 
 
+// VARIABLE INDEX
+// GetVarPtr() used to compare the hash of every variable in external RAM
+// until it found the one it wanted.  Now each space (simple variables and
+// arrays) has an open addressed hash table in XDATA that maps the variable
+// hash to its offset from the start of that space.  Offsets are used
+// instead of addresses so that nothing has to change when a whole space
+// is moved up by AllocSimpleVar() or by editing the program.  If a table
+// fills up, new variables are no longer added to it and lookups that miss
+// fall back to the old linear scan.
+
+#ifndef VAR_INDEX_SIZE
+#ifdef __C51__
+#define VAR_INDEX_SIZE   32       // must be a power of 2
+#else
+#define VAR_INDEX_SIZE   512
+#endif
+#endif
+
+#define VAR_INDEX_MAX   (VAR_INDEX_SIZE - VAR_INDEX_SIZE / 4)  // keep 1/4 empty
+
+XDATA DWORD VarIdxKey[2][VAR_INDEX_SIZE];  // Variable hash
+XDATA WORD VarIdxOfs[2][VAR_INDEX_SIZE];   // Offset in space + 1, 0 = empty
+WORD VarIdxCount[2];                       // Entries in use
+BYTE VarIdxFull[2];                        // Some variables are not indexed
+WORD VarFreeOfs;                           // Offset of first free simple var
+
+
+// Empty the index for one variable space.
+// Space is 0 for simple variables or VARPTR_ARRAY for arrays.
+
+void ClearVarIndex(BYTE Space)
+{
+    WORD i;
+
+    for (i = 0; i != VAR_INDEX_SIZE; i++) VarIdxOfs[Space][i] = 0;
+    VarIdxCount[Space] = 0;
+    VarIdxFull[Space] = FALSE;
+}
+
+
+// Return the first slot to probe for the hash in uHash.
+
+WORD VarIndexSlot(void)
+{
+    WORD h;
+
+    h = (WORD)((WORD) uHash.d ^ (WORD)(uHash.d >> 16));
+    h ^= (WORD)(h >> 7);
+
+    return((WORD)(h & (VAR_INDEX_SIZE - 1)));
+}
+
+
+// Look up uHash in the index.
+// Return its offset in the space + 1, or 0 if it isn't in the index.
+
+WORD FindVarIndex(BYTE Space)
+{
+    WORD Slot, Ofs;
+
+    Slot = VarIndexSlot();
+    while ((Ofs = VarIdxOfs[Space][Slot]) != 0)
+    {
+        STAT_INC(STAT_VAR_PROBES);
+        if (VarIdxKey[Space][Slot] == uHash.d) return(Ofs);
+        Slot = (WORD)((Slot + 1) & (VAR_INDEX_SIZE - 1));
+    }
+
+    return(0);
+}
+
+
+// Add uHash to the index with the given offset into its space.
+
+void AddVarIndex(BYTE Space, WORD Ofs)
+{
+    WORD Slot;
+
+    if (VarIdxCount[Space] == VAR_INDEX_MAX)
+    {
+        VarIdxFull[Space] = TRUE;   // lookups must scan from now on
+        return;
+    }
+
+    Slot = VarIndexSlot();
+    while (VarIdxOfs[Space][Slot])
+        Slot = (WORD)((Slot + 1) & (VAR_INDEX_SIZE - 1));
+
+    VarIdxKey[Space][Slot] = uHash.d;
+    VarIdxOfs[Space][Slot] = (WORD)(Ofs + 1);
+    VarIdxCount[Space]++;
+}
+
+
+// Rebuild the array index by walking the array space.
+// Needed after an array is deleted and the ones above it moved down.
+
+void BuildArrayIndex(void)
+{
+    WORD ptr;
+    UVAL_HASH Save;
+
+    Save = uHash;
+    ClearVarIndex(VARPTR_ARRAY);
+
+    for (ptr = BasicVars.DimStart; ptr < BasicVars.GosubStackBot; )
+    {
+        uHash.d = (DWORD) ReadRandomLong(ptr);
+        AddVarIndex(VARPTR_ARRAY, (WORD)(ptr - BasicVars.DimStart));
+        ptr += (WORD)(sizeof(UVAL_HASH) + ReadRandomWord((WORD)(ptr + sizeof(UVAL_HASH))));
+    }
+
+    uHash = Save;
+}
+
+
+// Rebuild both indexes by walking the variables in RAM, and forget any
+// cached references.  Needed when RAM has been replaced as a whole.
+
+void RebuildVarIndex(void)
+{
+    WORD ptr;
+    UVAL_HASH Save;
+
+    Save = uHash;
+    ClearVarIndex(0);
+
+    for (ptr = BasicVars.VarStart; ptr < BasicVars.DimStart;
+         ptr += (WORD)(sizeof(UVAL_HASH) + sizeof(UVAL_DATA)))
+    {
+        uHash.d = (DWORD) ReadRandomLong(ptr);
+        if (uHash.d == 0) break;   // first free slot
+        AddVarIndex(0, (WORD)(ptr - BasicVars.VarStart));
+    }
+    VarFreeOfs = (WORD)(ptr - BasicVars.VarStart);
+
+    uHash = Save;
+    BuildArrayIndex();
+    BumpVarGeneration();
+}
+
+
+// VARIABLE REFERENCE CACHE
+// Every variable reference in the program carries the variable name and
+// hash, which used to be looked up again each time the reference ran.
+// Now the result of the lookup is remembered for each reference, in a
+// direct mapped table keyed on the address of the reference.  Each entry
+// is stamped with VarGeneration, which is bumped whenever a variable may
+// have moved or changed type, so a stale entry is never used.  Program
+// edits always clear the variables, which bumps it as well.
+
+#ifndef VAR_CACHE_SIZE
+#ifdef __C51__
+#define VAR_CACHE_SIZE   16       // must be a power of 2
+#else
+#define VAR_CACHE_SIZE   256      // at most 256
+#endif
+#endif
+
+XDATA WORD VarCacheAddr[VAR_CACHE_SIZE];  // Address of the reference
+XDATA WORD VarCacheGen[VAR_CACHE_SIZE];   // VarGeneration when stored
+XDATA WORD VarCachePtr[VAR_CACHE_SIZE];   // Pointer to the variable
+XDATA DWORD VarCacheHash[VAR_CACHE_SIZE]; // Hash with the type filled in
+XDATA BYTE VarCacheSkip[VAR_CACHE_SIZE];  // Length of the reference
+WORD VarGeneration = 1;
+
+
+// Invalidate every cached variable reference.
+
+void BumpVarGeneration(void)
+{
+    WORD i;
+
+    if (++VarGeneration == 0)   // wrapped, old stamps could match again
+    {
+        for (i = 0; i != VAR_CACHE_SIZE; i++) VarCacheGen[i] = 0;
+        VarGeneration = 1;
+    }
+}
+
+
+
 // Clear the variables but leave the program space alone
 
 void ClearVariables(void)
@@ -61,6 +251,10 @@ void ClearVariables(void)
         DefTypes[x] = (BYTE)(TOKEN_FLOAT_VAR - TOKEN_NOTYPE_VAR);
     for (x = 0; x != 16; x++) BasicVars.FreeList[x] = 0;    
 
+    ClearVarIndex(0);     // simple variables
+    ClearVarIndex(VARPTR_ARRAY);
+    VarFreeOfs = 0;
+    BumpVarGeneration();
 }
 
 
@@ -71,6 +265,10 @@ void ClearEverything(void)
     // Initialize BasicVars Structure - Zero up
     BasicVars.ProgStart = sizeof(BasicVars);
     BasicVars.VarStart = sizeof(BasicVars);
+    InvalidateLineIndex();
+    ClearExprCache();
+    ClearVMCache();
+    ForgetLinks();    // no program, so nothing is linked
     ClearVariables();
 }
 
@@ -78,11 +276,12 @@ void ClearEverything(void)
 
 // This code is the equivalent CRC16 code that the Laser Bee does in hardware.
 // It is nearly verbatim from the Laser Bee Manual.
+// It is only used to build CRCTable[] below, so the 8051 does without it.
 
+#ifndef __C51__
 #define POLY 0x1021
-WORD UpdateCRC (WORD CRC_acc, BYTE CRC_input)
+WORD UpdateCRCBits (WORD CRC_acc, BYTE CRC_input)
 {
-#ifdef __BORLANDC__
     BYTE i; // loop counter
 
     // Create the CRC "dividend" for polynomial arithmetic (binary arithmetic
@@ -110,10 +309,36 @@ WORD UpdateCRC (WORD CRC_acc, BYTE CRC_input)
         }
     }
 
-#endif
     // Return the final remainder (CRC value)
     return CRC_acc;
 }
+#endif
+
+
+// Same CRC, a byte at a time from a table instead of a bit at a time.
+// The table is built from UpdateCRCBits() the first time it's needed, so
+// the hashes are identical.  The 8051 keeps the hardware CRC.
+
+#ifndef __C51__
+WORD CRCTable[256];
+BIT CRCTableReady;
+#endif
+
+WORD UpdateCRC (WORD CRC_acc, BYTE CRC_input)
+{
+#ifndef __C51__
+    if (!CRCTableReady)
+    {
+        WORD i;
+
+        for (i = 0; i != 256; i++) CRCTable[i] = UpdateCRCBits(0, (BYTE) i);
+        CRCTableReady = TRUE;
+    }
+
+    CRC_acc = (WORD)((CRC_acc << 8) ^ CRCTable[(BYTE)((CRC_acc >> 8) ^ CRC_input)]);
+#endif
+    return CRC_acc;
+}
 
 
 
@@ -312,6 +537,7 @@ WORD AllocSimpleVar(BYTE Count)
     BasicVars.GosubStackBot += Size;
     BasicVars.GosubStackTop += Size;
     FreeTempAlloc();
+    BumpVarGeneration();
 
     // Return pointer to start of NEW space.
     return((WORD)(BasicVars.DimStart - Size));
@@ -334,20 +560,40 @@ WORD GetVarPtr(BYTE Flags)
 {
     WORD StartPtr, StopPtr, Len;
     UVAL_HASH hash;
+    BYTE Space;
+
+    STAT_INC(STAT_VAR_LOOKUPS);
+    Space = (BYTE)(Flags & VARPTR_ARRAY);
 
     StartPtr = BasicVars.VarStart;     // default simple space
     StopPtr = BasicVars.DimStart;
 
-    if (Flags & VARPTR_ARRAY)   // array space
+    if (Space)   // array space
     {
 	    StartPtr = BasicVars.DimStart;
     	StopPtr = BasicVars.GosubStackBot;
     }
 
+    // Try the index first
+    Len = FindVarIndex(Space);
+    if (Len) return((WORD)(StartPtr + Len - 1 + sizeof(UVAL_HASH)));
+
+    // Not indexed.  If every variable is, there is no need to scan.
+    if (!VarIdxFull[Space])
+    {
+        if (!(Flags & VARPTR_ASSIGN) || Space) return(NULL);
+
+        // New simple variable goes in the first free slot
+        StartPtr = (WORD)(BasicVars.VarStart + VarFreeOfs);
+        if (StartPtr < BasicVars.DimStart) goto Assign;
+        StopPtr = StartPtr;   // no free slots, skip the scan
+    }
+
     while (StartPtr < StopPtr)
     {
         // read hash
     	ReadBlock51((BYTE *) &hash, StartPtr, sizeof(UVAL_HASH));
+        STAT_INC(STAT_VAR_PROBES);
 
         // Check for an empty memory location
         if (hash.d == 0)    // found clear variable
@@ -381,6 +627,8 @@ WORD GetVarPtr(BYTE Flags)
 Assign:
     // we are making an assignment so write hash
    	WriteBlock51(StartPtr, (BYTE *) &uHash, sizeof(UVAL_HASH));
+    AddVarIndex(0, VarFreeOfs);
+    VarFreeOfs += (WORD)(sizeof(UVAL_HASH) + sizeof(UVAL_DATA));
 
     // return pointing to actual variable
     return((WORD)(StartPtr + sizeof(UVAL_HASH))); // return pointer to new variable
@@ -435,13 +683,39 @@ void ReadProgVarHash(void)
 // Read variable name and hash from program file and store in uHash.
 // Stream should point to the first byte after the token.
 // Then return a pointer to the variable.
+// References in the program are looked up in the cache first.
 
 WORD GetProgVarPtr(BYTE Flags)
 {
+    WORD Addr, VarPtr;
+    BYTE Slot;
+
+    Addr = GetStreamAddr();
+    Slot = (BYTE)((Addr ^ (Addr >> 8)) & (VAR_CACHE_SIZE - 1));
+
+    if (VarCacheAddr[Slot] == Addr && VarCacheGen[Slot] == VarGeneration)
+    {
+        uHash.d = VarCacheHash[Slot];
+        StreamSkip(VarCacheSkip[Slot]);
+        return(VarCachePtr[Slot]);
+    }
+
     ReadProgVarHash();
 
     // Get pointer to simple variable for reading
-    return(GetVarPtr(Flags));
+    VarPtr = GetVarPtr(Flags);
+
+    // Only remember references in the program, the command line is reused
+    if (VarPtr && Addr >= BasicVars.ProgStart && Addr < BasicVars.VarStart)
+    {
+        VarCacheAddr[Slot] = Addr;
+        VarCacheGen[Slot] = VarGeneration;
+        VarCachePtr[Slot] = VarPtr;
+        VarCacheHash[Slot] = uHash.d;
+        VarCacheSkip[Slot] = (BYTE)(GetStreamAddr() - Addr);
+    }
+
+    return(VarPtr);
 }
 
 
@@ -717,11 +991,13 @@ BIT MakeArray(BYTE ArgCnt)
 
     // Copy the new array header in
     WriteBlock51(BasicVars.GosubStackBot, TokBuf, HeadIdx);
+    AddVarIndex(VARPTR_ARRAY, (WORD)(BasicVars.GosubStackBot - BasicVars.DimStart));
 
     // adjust all the pointers
     BasicVars.GosubStackBot += DimSizeW;
     BasicVars.GosubStackTop += DimSizeW;
     FreeTempAlloc();
+    BumpVarGeneration();
 
     return(FALSE);
 
@@ -751,6 +1027,9 @@ void DeleteArray(void)
     BasicVars.GosubStackBot -= DimSize;
     BasicVars.GosubStackTop -= DimSize;
     FreeTempAlloc();
+
+    BuildArrayIndex();    // arrays above this one have moved
+    BumpVarGeneration();
 }
 
 